@@ -7,6 +7,7 @@
 #define INCLUDE_AUDIO_BASE_ANALYZER_H_
 
 #include "model/application_error.h"
+#include "model/audio_spectrum.h"
 
 namespace driver {
 
@@ -40,7 +41,7 @@ class Analyzer {
    * @param size Input vector size
    * @param out Output vector where each entry represents a frequency bar
    */
-  virtual error::Code Execute(double *in, int size, double *out) = 0;
+  virtual error::Code Execute(model::Sample *in, int size, model::Sample *out) = 0;
 
   /**
    * @brief Get internal buffer size
@@ -82,7 +82,7 @@ class Notifier {
    * @brief Notify Audio Player about playlist selected by user
    * @param playlist Song queue
    */
-  virtual void NotifyPlaylistSelection(const model::Playlist& playlist) = 0;
+  virtual void NotifyPlaylistSelection(const model::SharedPlaylist& playlist) = 0;
 };
 
 }  // namespace audio
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief  Class to support using the built-in FFT as backend for audio analysis
+ */
+
+#ifndef INCLUDE_AUDIO_DRIVER_BUILTIN_FFT_H_
+#define INCLUDE_AUDIO_DRIVER_BUILTIN_FFT_H_
+
+#include <memory>
+
+#include "audio/driver/spectrum_analyzer.h"
+
+namespace driver {
+
+/**
+ * @brief Provides an interface to apply frequency analysis on audio samples by using the built-in
+ * FFT, without any external dependency (and no planning at all, as every table is created at
+ * compile time)
+ */
+class BuiltinFft final : public SpectrumAnalyzer {
+ public:
+  /**
+   * @brief Construct a new BuiltinFft object
+   */
+  BuiltinFft() = default;
+
+  /**
+   * @brief Destroy the BuiltinFft object
+   */
+  ~BuiltinFft() override = default;
+
+  /* ******************************************************************************************** */
+  //! Interface for FFT backend
+ private:
+  /**
+   * @brief Create built-in plan
+   * @param size Transform size (must be one of the sizes supported by built-in FFT)
+   * @param howmany Quantity of transforms to execute at once
+   * @param in Input data
+   * @param out Output data
+   * @return Built-in plan, or nullptr if size is not supported
+   */
+  std::unique_ptr<Transform> CreateTransform(int size, int howmany, Real *in,
+                                             Complex *out) override;
+
+  class Plan;  //!< Built-in plan
+};
+
+}  // namespace driver
+#endif  // INCLUDE_AUDIO_DRIVER_BUILTIN_FFT_H_
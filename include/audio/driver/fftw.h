@@ -1,31 +1,35 @@
 /**
  * \file
- * \brief  Class to support using FFTW3
+ * \brief  Class to support using FFTW3 as backend for audio analysis
  */
 
 #ifndef INCLUDE_AUDIO_DRIVER_FFTW_H_
 #define INCLUDE_AUDIO_DRIVER_FFTW_H_
 
-#include <fftw3.h>
-
+#include <chrono>
 #include <memory>
-#include <mutex>
-#include <vector>
+#include <string>
 
-#include "audio/base/analyzer.h"
-#include "model/application_error.h"
+#include "audio/driver/spectrum_analyzer.h"
 
 namespace driver {
 
 /**
- * @brief Provides an interface to apply frequency analysis on audio samples by using FFT
+ * @brief Provides an interface to apply frequency analysis on audio samples by using FFTW3, where
+ * plans are cached as FFTW wisdom in a file, to skip measuring them again on the next executions
  */
-class FFTW final : public Analyzer {
+class FFTW final : public SpectrumAnalyzer {
  public:
+  /**
+   * @brief Construct a new FFTW object (caching FFTW wisdom in the default path)
+   */
+  FFTW();
+
   /**
    * @brief Construct a new FFTW object
+   * @param wisdom_path Full path to file where FFTW wisdom is cached
    */
-  FFTW() = default;
+  explicit FFTW(const std::string &wisdom_path);
 
   /**
    * @brief Destroy the FFTW object
@@ -36,126 +40,48 @@ class FFTW final : public Analyzer {
   //! Public API
 
   /**
-   * @brief Initialize internal structures for audio analysis
-   * @param output_size Size for output vector from Execute
-   */
-  error::Code Init(int output_size) override;
-
-  /**
-   * @brief Run FFT on input vector to get information about audio in the frequency domain
-   * @param in Input vector with audio raw data (signal amplitude)
-   * @param size Input vector size
-   * @param out Output vector where each entry represents a frequency bar
-   */
-  error::Code Execute(double *in, int size, double *out) override;
-
-  /**
-   * @brief Get internal buffer size
-   * @return Maximum size for input vector
+   * @brief Statistics about FFTW plans creation (only done once, by the first Init call)
    */
-  int GetBufferSize() override { return kBufferSize; }
+  struct PlanStatistics {
+    std::chrono::milliseconds elapsed{0};  //!< Time spent creating plans
+    bool imported = false;                 //!< Wisdom was imported from file
+    bool measured = false;                 //!< Some plan had to be measured (missing from wisdom)
+  };
 
   /**
-   * @brief Get output buffer size
-   * @return Size for output vector (considering number of bars multiplied per number of channels)
+   * @brief Get statistics about FFTW plans creation
+   * @return Plans statistics (all zeroed if Init was never called)
    */
-  int GetOutputSize() override { return output_size_; }
+  PlanStatistics GetPlanStatistics();
 
   /* ******************************************************************************************** */
-  //! Custom declarations with deleters
+  //! Interface for FFT backend
  private:
-  struct RealDeleter {
-    void operator()(double *p) const { fftw_free(p); }
-  };
-
-  struct ComplexDeleter {
-    void operator()(fftw_complex *p) const { fftw_free(p); }
-  };
-
-  struct PlanDeleter {
-    void operator()(fftw_plan_s *p) const { fftw_destroy_plan(p); }
-  };
-
-  using FFTReal = std::unique_ptr<double, RealDeleter>;
-  using FFTComplex = std::unique_ptr<fftw_complex, ComplexDeleter>;
-  using FFTPlan = std::unique_ptr<fftw_plan_s, PlanDeleter>;
-
   /**
-   * @brief Audio frequency analysis
+   * @brief Create FFTW plans, importing wisdom from file before it and exporting it afterwards
+   * @return true if all plans were created, otherwise false
    */
-  struct FreqAnalysis {
-    int buffer_size;                    //!< Buffer size for this audio range analysis
-    FFTPlan plan_left, plan_right;      //!< FFTW Plan (define input and output size to perform DFT)
-    FFTComplex out_left, out_right;     //!< One-dimensional DFT output per channel
-    FFTReal multiplier;                 //!< Hanning Window
-    FFTReal in_raw_left, in_raw_right;  //!< Raw audio input data per channel
-    FFTReal in_left, in_right;          //!< Audio input data with windowing applied per channel
-  };
+  bool CreatePlans() override;
 
-  /* ******************************************************************************************** */
-  //! Private methods
- private:
-  // From init
-  void CreateHannWindow(FreqAnalysis &analysis);
-  void CreateFftwStructure(FreqAnalysis &analysis);
-  void CreateBuffers();
-  void CalculateFrequencies();
-
-  // From execute
-  void FillInputBuffer(double *in, int &size, int &silence);
-  void ApplyFft(FreqAnalysis &analysis);
-  void SeparateFreqBands(double *out);
-  void AdjustResults(double *out, int silence);
-
-  /* ******************************************************************************************** */
-  //! Default Constants
-
-  static constexpr int kBufferSize = 1024;   //!< Base size for buffers
-  static constexpr int kNumberBars = 10;     //!< Quantity of bars to represent audio spectrum
-  static constexpr int kNumberChannels = 2;  //!< Always consider input audio data as stereo
-
-  static constexpr int kLowCutOff = 50;      //!< Low frequency to cut off (in Hz)
-  static constexpr int kHighCutOff = 10000;  //!< High frequency to cut off (in Hz)
-
-  static constexpr int kSampleRate = 44100;  //!< Audio data sample rate
+  /**
+   * @brief Create FFTW plan (using wisdom, if available, otherwise measuring it)
+   * @param size Transform size
+   * @param howmany Quantity of transforms to execute at once
+   * @param in Input data
+   * @param out Output data
+   * @return FFTW plan
+   */
+  std::unique_ptr<Transform> CreateTransform(int size, int howmany, Real *in,
+                                             Complex *out) override;
 
-  static constexpr float kNoiseReduction =
-      0.77f;  //!< Adjusts the integral and gravity filters to keep the signal smooth
+  class Plan;  //!< FFTW plan (in double or single precision, chosen at build time)
 
   /* ******************************************************************************************** */
   //! Variables
  private:
-  std::mutex mutex_;  //!< Control access for internal resources
-
-  FreqAnalysis bass_, mid_, treble_;  //!< Split audio spectrum analysis between three audio ranges
-
-  //! Input data
-  double input_size_;          //!< Maximum size for input buffer
-  std::vector<double> input_;  //!< Input buffer with raw audio data
-
-  //! To smooth results after applying FFT
-  std::vector<double> previous_output_, memory_, peak_;
-  std::vector<int> fall_;
-
-  //! Distribute bars across the frequency band (based on output from FFT)
-  std::vector<float> cut_off_freq_;  //!< Cut-off frequency per bar
-  int bass_cut_off_;                 //!< Maximum frequency in bass range
-  int treble_cut_off_;               //!< Minimum frequency in treble range
-
-  std::vector<int> lower_cut_off_per_bar_;  //!< Contains the lowest frequency per bar
-  std::vector<int> upper_cut_off_per_bar_;  //!< Contains the highest frequency per bar
-
-  std::vector<double> equalizer_;  //!< Normalize output from audio analysis
-
-  double frame_rate_;  //!< Frames per second for UI refresh
-  int frame_skip_;     //!< Counter for skipped frames when no input is available to analyze
-
-  double sensitivity_;  //!< Sensitivity adjustment, to dynamic regulate output signal from 0 to 1
-  int sens_init_;  //!< Previous value for sensitivity adjustment (this is to ensure that output
-                   //!< signal won't exceed maximum value)
-
-  int bars_per_channel_;  //!< Maximum number of bars per channel
-  int output_size_;       //!< Maximum output size from audio analysis
+  std::string wisdom_path_;         //!< Full path to file where FFTW wisdom is cached
+  PlanStatistics plan_statistics_;  //!< Statistics about FFTW plans creation
+  bool measured_ = false;           //!< Some plan had to be measured while creating plans
 };
 
 }  // namespace driver
@@ -0,0 +1,273 @@
+/**
+ * \file
+ * \brief  Built-in FFT for real input data (dependency-free replacement for FFTW3)
+ */
+
+#ifndef INCLUDE_AUDIO_DRIVER_INTERNAL_FFT_H_
+#define INCLUDE_AUDIO_DRIVER_INTERNAL_FFT_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "model/audio_spectrum.h"
+
+namespace driver {
+
+namespace internal {
+
+namespace fft {
+
+//! Complex number, using the same memory layout from FFTW (real part followed by imaginary part)
+using Complex = model::Sample[2];
+
+//! Transform sizes supported by Plan (the ones used by audio analysis)
+static constexpr std::array<int, 3> kSupportedSizes{1024, 4096, 8192};
+
+/* ********************************************************************************************** */
+//! Compile-time math (std::sin and std::cos are not constexpr in C++17)
+
+static constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Calculate sine using a Taylor series (accurate enough for angles within [-pi, pi])
+ * @param x Angle in radians
+ * @return Sine value
+ */
+constexpr double Sine(double x) {
+  double term = x;
+  double sum = x;
+
+  for (int n = 1; n < 20; n++) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+
+  return sum;
+}
+
+/**
+ * @brief Calculate cosine using a Taylor series (accurate enough for angles within [-pi, pi])
+ * @param x Angle in radians
+ * @return Cosine value
+ */
+constexpr double Cosine(double x) {
+  double term = 1;
+  double sum = 1;
+
+  for (int n = 1; n < 20; n++) {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+
+  return sum;
+}
+
+/* ********************************************************************************************** */
+//! Compile-time tables
+
+/**
+ * @brief Twiddle factors W(k) = exp(-2 * pi * i * k / N), for every k in [0, N/2)
+ */
+template <typename T, int N>
+struct Twiddles {
+  std::array<T, N / 2> real{};  //!< Real part (cosine)
+  std::array<T, N / 2> imag{};  //!< Imaginary part (negative sine)
+};
+
+/**
+ * @brief Create twiddle factors table for a transform of size N
+ * @return Twiddle factors
+ */
+template <typename T, int N>
+constexpr Twiddles<T, N> MakeTwiddles() {
+  Twiddles<T, N> table{};
+
+  for (int k = 0; k < N / 2; k++) {
+    double angle = 2 * kPi * k / N;
+    table.real[k] = static_cast<T>(Cosine(angle));
+    table.imag[k] = static_cast<T>(-Sine(angle));
+  }
+
+  return table;
+}
+
+/**
+ * @brief Create table with bit-reversed indexes, used to reorder input for an in-place FFT
+ * @return Bit-reversed indexes
+ */
+template <int M>
+constexpr std::array<uint16_t, M> MakeBitReversal() {
+  std::array<uint16_t, M> table{};
+
+  int bits = 0;
+  while ((1 << bits) < M) bits++;
+
+  for (int n = 0; n < M; n++) {
+    int reversed = 0;
+    for (int b = 0; b < bits; b++) {
+      if (n & (1 << b)) reversed |= 1 << (bits - 1 - b);
+    }
+
+    table[n] = static_cast<uint16_t>(reversed);
+  }
+
+  return table;
+}
+
+/* ********************************************************************************************** */
+
+/**
+ * @brief FFT for real input data with a fixed size, where every table is created at compile time.
+ * Real input of size N is packed into a complex FFT of size N/2 (even samples as real part and odd
+ * samples as imaginary part), and then, both halves are split apart to get the N/2+1 results.
+ * This gives the same output from an FFTW r2c plan (unnormalized, negative exponent).
+ */
+template <typename T, int N>
+class RealFft {
+  static_assert(N >= 4 && (N & (N - 1)) == 0, "FFT size must be a power of two");
+  static_assert(N / 2 <= UINT16_MAX + 1, "FFT size too big for bit-reversal table");
+
+ public:
+  static constexpr int kSize = N;                //!< Input size (real numbers)
+  static constexpr int kOutputSize = N / 2 + 1;  //!< Output size (complex numbers)
+  static constexpr int kScratchSize = N;         //!< Scratch size (real numbers)
+
+  /**
+   * @brief Run FFT on real input data
+   * @param in Input with N real numbers
+   * @param out Output with N/2+1 complex numbers (stored as interleaved real and imaginary parts)
+   * @param scratch Working memory with N real numbers (so this can run without any allocation)
+   */
+  static void Forward(const T* in, T* out, T* scratch) {
+    // Pack input as complex numbers, already in bit-reversed order for the butterflies
+    for (int n = 0; n < kHalf; n++) {
+      int index = kReversal[n] * 2;
+      scratch[index] = in[n * 2];
+      scratch[index + 1] = in[n * 2 + 1];
+    }
+
+    // Radix-2 butterflies, where twiddle for a block with length "len" is W(j * N / len)
+    for (int len = 2; len <= kHalf; len *= 2) {
+      int half = len / 2;
+      int stride = N / len;
+
+      for (int start = 0; start < kHalf; start += len) {
+        T* a = scratch + start * 2;
+        T* b = scratch + (start + half) * 2;
+
+        for (int j = 0; j < half; j++) {
+          T w_real = kTwiddles.real[j * stride];
+          T w_imag = kTwiddles.imag[j * stride];
+
+          T real = b[j * 2] * w_real - b[j * 2 + 1] * w_imag;
+          T imag = b[j * 2] * w_imag + b[j * 2 + 1] * w_real;
+
+          b[j * 2] = a[j * 2] - real;
+          b[j * 2 + 1] = a[j * 2 + 1] - imag;
+          a[j * 2] += real;
+          a[j * 2 + 1] += imag;
+        }
+      }
+    }
+
+    // Split results from even (E) and odd (O) samples, to get X(k) = E(k) + W(k) * O(k)
+    out[0] = scratch[0] + scratch[1];
+    out[1] = 0;
+    out[kHalf * 2] = scratch[0] - scratch[1];
+    out[kHalf * 2 + 1] = 0;
+
+    for (int k = 1; k < kHalf; k++) {
+      // Z(k) and conjugate of Z(N/2 - k)
+      T a_real = scratch[k * 2];
+      T a_imag = scratch[k * 2 + 1];
+      T b_real = scratch[(kHalf - k) * 2];
+      T b_imag = -scratch[(kHalf - k) * 2 + 1];
+
+      // E(k) = (Z(k) + conj(Z(N/2 - k))) / 2 and O(k) = (Z(k) - conj(Z(N/2 - k))) / 2i
+      T even_real = (a_real + b_real) / 2;
+      T even_imag = (a_imag + b_imag) / 2;
+      T odd_real = (a_imag - b_imag) / 2;
+      T odd_imag = (b_real - a_real) / 2;
+
+      T w_real = kTwiddles.real[k];
+      T w_imag = kTwiddles.imag[k];
+
+      out[k * 2] = even_real + odd_real * w_real - odd_imag * w_imag;
+      out[k * 2 + 1] = even_imag + odd_real * w_imag + odd_imag * w_real;
+    }
+  }
+
+ private:
+  static constexpr int kHalf = N / 2;  //!< Size for the complex FFT
+
+  static constexpr Twiddles<T, N> kTwiddles = MakeTwiddles<T, N>();  //!< Twiddle factors
+  static constexpr std::array<uint16_t, N / 2> kReversal =
+      MakeBitReversal<N / 2>();  //!< Bit-reversed indexes
+};
+
+/* ********************************************************************************************** */
+//! Runtime API, using the same shape from the FFTW API subset used by audio analysis
+
+/**
+ * @brief Batched transform for real input data (equivalent to an FFTW plan from
+ * fftw_plan_many_dft_r2c using contiguous data)
+ */
+struct Plan {
+  int size;                            //!< Transform size
+  int howmany;                         //!< Quantity of transforms to execute
+  model::Sample* in;                   //!< Input data
+  int idist;                           //!< Distance between each input
+  Complex* out;                        //!< Output data
+  int odist;                           //!< Distance between each output
+  std::vector<model::Sample> scratch;  //!< Working memory
+};
+
+/**
+ * @brief Allocate aligned memory for real numbers
+ * @param n Quantity of real numbers
+ * @return Pointer to allocated memory
+ */
+model::Sample* AllocReal(size_t n);
+
+/**
+ * @brief Allocate aligned memory for complex numbers
+ * @param n Quantity of complex numbers
+ * @return Pointer to allocated memory
+ */
+Complex* AllocComplex(size_t n);
+
+/**
+ * @brief Release memory allocated by AllocReal or AllocComplex
+ * @param p Pointer to allocated memory
+ */
+void Free(void* p);
+
+/**
+ * @brief Create plan to run batched transforms for real input data (only contiguous data in a
+ * single dimension is supported, and transform size must be one of kSupportedSizes)
+ * @return Plan, or nullptr if arguments are not supported
+ */
+Plan* PlanManyDftR2C(int rank, const int* n, int howmany, model::Sample* in, const int* inembed,
+                     int istride, int idist, Complex* out, const int* onembed, int ostride,
+                     int odist, unsigned flags);
+
+/**
+ * @brief Execute transforms from plan
+ * @param plan Plan
+ */
+void Execute(Plan* plan);
+
+/**
+ * @brief Release plan
+ * @param plan Plan
+ */
+void DestroyPlan(Plan* plan);
+
+}  // namespace fft
+
+}  // namespace internal
+
+}  // namespace driver
+#endif  // INCLUDE_AUDIO_DRIVER_INTERNAL_FFT_H_
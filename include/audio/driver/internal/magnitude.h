@@ -0,0 +1,34 @@
+/**
+ * \file
+ * \brief  Kernel to sum magnitudes from FFT results
+ */
+
+#ifndef INCLUDE_AUDIO_DRIVER_INTERNAL_MAGNITUDE_H_
+#define INCLUDE_AUDIO_DRIVER_INTERNAL_MAGNITUDE_H_
+
+#include "model/audio_spectrum.h"
+
+namespace driver {
+
+namespace internal {
+
+/**
+ * @brief Sum magnitude from a contiguous range of complex numbers (using SIMD when available)
+ * @param data Complex numbers stored as interleaved pairs of real and imaginary parts
+ * @param count Quantity of complex numbers
+ * @return Sum of magnitudes
+ */
+model::Sample SumMagnitudes(const model::Sample* data, int count);
+
+/**
+ * @brief Sum magnitude from a contiguous range of complex numbers (using scalar instructions)
+ * @param data Complex numbers stored as interleaved pairs of real and imaginary parts
+ * @param count Quantity of complex numbers
+ * @return Sum of magnitudes
+ */
+model::Sample SumMagnitudesScalar(const model::Sample* data, int count);
+
+}  // namespace internal
+
+}  // namespace driver
+#endif  // INCLUDE_AUDIO_DRIVER_INTERNAL_MAGNITUDE_H_
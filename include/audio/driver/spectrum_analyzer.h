@@ -0,0 +1,265 @@
+/**
+ * \file
+ * \brief  Base class with the audio analysis shared by every FFT backend (FFTW3 or built-in FFT)
+ */
+
+#ifndef INCLUDE_AUDIO_DRIVER_SPECTRUM_ANALYZER_H_
+#define INCLUDE_AUDIO_DRIVER_SPECTRUM_ANALYZER_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "audio/base/analyzer.h"
+#include "model/application_error.h"
+#include "model/audio_spectrum.h"
+
+#ifdef ENABLE_TESTS
+namespace {
+template <typename T>
+class AnalyzerTest;
+}
+#endif
+
+namespace driver {
+
+/**
+ * @brief Frequency analysis on audio samples split into three audio ranges (bass, mid and treble),
+ * where the transform itself is created by a derived class for the FFT backend in use
+ */
+class SpectrumAnalyzer : public Analyzer {
+ protected:
+  /**
+   * @brief Construct a new SpectrumAnalyzer object
+   */
+  SpectrumAnalyzer() = default;
+
+ public:
+  /**
+   * @brief Destroy the SpectrumAnalyzer object
+   */
+  ~SpectrumAnalyzer() override = default;
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Initialize internal structures for audio analysis. If called while analysis is already
+   * running, the new state is built aside and only swapped in by the end of the next Execute call
+   * @param output_size Size for output vector from Execute
+   */
+  error::Code Init(int output_size) override;
+
+  /**
+   * @brief Run FFT on input vector to get information about audio in the frequency domain
+   * @param in Input vector with audio raw data (signal amplitude)
+   * @param size Input vector size
+   * @param out Output vector where each entry represents a frequency bar
+   */
+  error::Code Execute(model::Sample *in, int size, model::Sample *out) override;
+
+  /**
+   * @brief Get internal buffer size (as input is kept in a history buffer sized for the biggest
+   * FFT, a single call to Execute may receive up to its whole capacity)
+   * @return Maximum size for input vector
+   */
+  int GetBufferSize() override { return kInputSize; }
+
+  /**
+   * @brief Get output buffer size
+   * @return Size for output vector (considering number of bars multiplied per number of channels)
+   */
+  int GetOutputSize() override;
+
+  /* ******************************************************************************************** */
+  //! Interface for FFT backend
+ protected:
+  using Real = model::Sample;  //!< Same precision from audio samples
+  using Complex = Real[2];     //!< Complex number (real part followed by imaginary part)
+
+  /**
+   * @brief Batched DFT for real input data, created once and executed for every frame
+   */
+  class Transform {
+   public:
+    virtual ~Transform() = default;
+
+    /**
+     * @brief Run DFT over the input and output buffers given on its creation
+     */
+    virtual void Execute() = 0;
+  };
+
+  /**
+   * @brief Create every transform used by audio analysis (called only once, by the first Init)
+   * @return true if all transforms were created, otherwise false
+   */
+  virtual bool CreatePlans();
+
+  /**
+   * @brief Create transform for contiguous input data (one input after another)
+   * @param size Transform size
+   * @param howmany Quantity of transforms to execute at once
+   * @param in Input data, with size real numbers per transform
+   * @param out Output data, with size/2+1 complex numbers per transform
+   * @return Transform, or nullptr if backend does not support it
+   */
+  virtual std::unique_ptr<Transform> CreateTransform(int size, int howmany, Real *in,
+                                                     Complex *out) = 0;
+
+  std::mutex init_mutex_;  //!< Serialize Init calls (FFT planner may not be thread-safe)
+
+  /* ******************************************************************************************** */
+  //! Custom declarations with deleters
+ private:
+  struct RealDeleter {
+    void operator()(Real *p) const;
+  };
+
+  struct ComplexDeleter {
+    void operator()(Complex *p) const;
+  };
+
+  using FFTReal = std::unique_ptr<Real, RealDeleter>;
+  using FFTComplex = std::unique_ptr<Complex, ComplexDeleter>;
+
+  /**
+   * @brief Audio frequency analysis
+   */
+  struct FreqAnalysis {
+    int buffer_size;     //!< Buffer size for this audio range analysis
+    int decimation = 1;  //!< Decimation factor applied to input (same resolution with smaller DFT)
+
+    //! Batched DFT (both channels are transformed at once)
+    std::unique_ptr<Transform> plan;
+
+    FFTComplex out;      //!< One-dimensional DFT output (left channel followed by right channel)
+    FFTReal multiplier;  //!< Hanning Window
+    FFTReal in;          //!< Audio input data with windowing applied (left followed by right)
+
+    //! Get DFT output from left channel
+    const Complex *out_left() const { return out.get(); }
+
+    //! Get DFT output from right channel
+    const Complex *out_right() const { return out.get() + buffer_size / 2 + 1; }
+  };
+
+  /**
+   * @brief Everything that depends on the output size, grouped together so that a new state can be
+   * built aside (without blocking Execute) and then swapped in at once
+   */
+  struct State {
+    //! To smooth results after applying FFT
+    std::vector<Real> previous_output, memory, peak;
+    std::vector<int> fall;
+
+    //! Distribute bars across the frequency band (based on output from FFT)
+    std::vector<float> cut_off_freq;  //!< Cut-off frequency per bar
+    int bass_cut_off;                 //!< Maximum frequency in bass range
+    int treble_cut_off;               //!< Minimum frequency in treble range
+
+    std::vector<int> lower_cut_off_per_bar;  //!< Contains the lowest frequency per bar
+    std::vector<int> upper_cut_off_per_bar;  //!< Contains the highest frequency per bar
+
+    std::vector<double> equalizer;  //!< Normalize output from audio analysis
+
+    //! Lookup tables per bar (built from the data above), to sum FFT results without any branch
+    std::vector<const FreqAnalysis *> analysis_per_bar;  //!< Audio range used by each bar
+    std::vector<Real> scale_per_bar;  //!< Equalizer divided by quantity of FFT results per bar
+
+    int bars_per_channel;  //!< Maximum number of bars per channel
+    int output_size;       //!< Maximum output size from audio analysis
+  };
+
+  /* ******************************************************************************************** */
+  //! Private methods
+ private:
+  // From init
+  void CreateDecimationFilter();
+  std::unique_ptr<State> CreateState(int output_size);
+  void CreateHannWindow(FreqAnalysis &analysis);
+  bool CreateFftStructure(FreqAnalysis &analysis);
+  void CreateBuffers(State &state);
+  void CalculateFrequencies(State &state);
+  void CreateLookupTables(State &state);
+
+  // From execute
+  void FillInputBuffer(Real *in, int &size, int &silence);
+  void Decimate(int frames);
+  void SplitChannels(const Real *newest, int frames, Real *raw);
+  void ApplyFft(FreqAnalysis &analysis, const Real *raw, int raw_size);
+  void SeparateFreqBands(State &state, Real *out);
+  void AdjustResults(State &state, Real *out, int silence);
+
+  /* ******************************************************************************************** */
+  //! Default Constants
+
+  static constexpr int kBufferSize = 1024;   //!< Base size for buffers
+  static constexpr int kNumberBars = 10;     //!< Quantity of bars to represent audio spectrum
+  static constexpr int kNumberChannels = 2;  //!< Always consider input audio data as stereo
+
+  static constexpr int kLowCutOff = 50;      //!< Low frequency to cut off (in Hz)
+  static constexpr int kHighCutOff = 10000;  //!< High frequency to cut off (in Hz)
+
+  static constexpr int kSampleRate = 44100;  //!< Audio data sample rate
+
+  static constexpr int kDecimationFactor = 8;  //!< Downsampling factor for input used by bass
+  static constexpr int kDecimationTaps = 64;   //!< Quantity of coefficients for low-pass filter
+
+  static constexpr float kNoiseReduction =
+      0.77f;  //!< Adjusts the integral and gravity filters to keep the signal smooth
+
+ public:
+  //! Maximum input size for Execute (history buffer sized for the biggest FFT, in both channels)
+  static constexpr int kInputSize = kBufferSize * 4 * kNumberChannels;
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::mutex mutex_;  //!< Control access for internal resources
+
+  //! Split audio spectrum analysis between three audio ranges (created once and reused by Init)
+  FreqAnalysis bass_, mid_, treble_;
+  bool plans_created_ = false;  //!< Flag to indicate that transforms were already created
+
+  //! Raw audio input split per channel (left followed by right), shared by mid and treble, as
+  //! treble simply uses the most recent samples from the same data used by mid
+  FFTReal raw_;
+  FFTReal raw_bass_;  //!< Decimated audio input split per channel (left followed by right)
+
+  std::unique_ptr<State> state_;    //!< State used by Execute
+  std::unique_ptr<State> pending_;  //!< State built by Init, waiting to be swapped in by Execute
+  std::unique_ptr<State> retired_;  //!< Previous state, released by next Init
+
+  //! Input data
+  int input_size_;           //!< Maximum size for input buffer
+  int input_capacity_;       //!< Input buffer size plus history needed by decimation filter
+  std::vector<Real> input_;  //!< Circular buffer with raw audio data (stored twice in a row, so the
+                             //!< most recent samples are always contiguous starting from head)
+  int head_ = 0;             //!< Position for the next sample (also the oldest sample in buffer)
+
+  //! Decimation (low-pass filter and downsampling) for input used by bass
+  std::vector<Real> decimation_filter_;  //!< FIR filter coefficients
+  std::vector<Real> decimated_;          //!< Circular buffer with decimated data (same as input_)
+  int decimated_size_;                   //!< Maximum size for decimated buffer
+  int decimated_head_ = 0;               //!< Position for the next decimated sample
+  int decimation_counter_ = 0;           //!< Quantity of frames received since last decimation
+
+  double frame_rate_ = 75;  //!< Frames per second for UI refresh
+  int frame_skip_ = 0;      //!< Counter for skipped frames when no input is available to analyze
+
+  double sensitivity_ = 1;  //!< Sensitivity adjustment, to dynamic regulate output signal (0 to 1)
+  int sens_init_ = 1;  //!< Previous value for sensitivity adjustment (this is to ensure that output
+                       //!< signal won't exceed maximum value)
+
+  /* ******************************************************************************************** */
+  //! Friend class for testing purpose
+
+#ifdef ENABLE_TESTS
+  template <typename T>
+  friend class ::AnalyzerTest;
+#endif
+};
+
+}  // namespace driver
+#endif  // INCLUDE_AUDIO_DRIVER_SPECTRUM_ANALYZER_H_
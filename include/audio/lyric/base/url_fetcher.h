@@ -6,6 +6,7 @@
 #ifndef INCLUDE_AUDIO_LYRIC_BASE_URL_FETCHER_H_
 #define INCLUDE_AUDIO_LYRIC_BASE_URL_FETCHER_H_
 
+#include <atomic>
 #include <string>
 
 #include "model/application_error.h"
@@ -34,9 +35,11 @@ class UrlFetcher {
    * @brief Fetch content from the given URL
    * @param URL Endpoint address
    * @param output Output from fetch (out)
+   * @param cancelled Fetch must be aborted as soon as possible when set (by another thread)
    * @return Error code from operation
    */
-  virtual error::Code Fetch(const std::string &URL, std::string &output) = 0;
+  virtual error::Code Fetch(const std::string &URL, std::string &output,
+                            const std::atomic<bool> &cancelled) = 0;
 };
 
 }  // namespace driver
@@ -8,6 +8,7 @@
 
 #include <curl/curl.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -37,9 +38,11 @@ class CURLWrapper : public driver::UrlFetcher {
    * @brief Fetch content from the given URL
    * @param URL Endpoint address
    * @param output Output from fetch (out)
+   * @param cancelled Fetch must be aborted as soon as possible when set (by another thread)
    * @return Error code from operation
    */
-  error::Code Fetch(const std::string &URL, std::string &output) override;
+  error::Code Fetch(const std::string &URL, std::string &output,
+                    const std::atomic<bool> &cancelled) override;
 
  private:
   /**
@@ -54,6 +57,20 @@ class CURLWrapper : public driver::UrlFetcher {
    */
   static size_t WriteCallback(const char *buffer, size_t size, size_t nmemb, void *data);
 
+  /**
+   * @brief This callback function gets called by libcurl frequently during transfer (even while
+   * resolving name or connecting to host, when no data is transferred at all), so it is used to
+   * abort transfer as soon as it gets cancelled.
+   * @param data Flag to cancel transfer
+   * @param dltotal Total bytes expected to download
+   * @param dlnow Bytes downloaded so far
+   * @param ultotal Total bytes expected to upload
+   * @param ulnow Bytes uploaded so far
+   * @return Non-zero value to abort transfer, otherwise zero
+   */
+  static int ProgressCallback(void *data, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal,
+                              curl_off_t ulnow);
+
   //! Smart pointer to manage CURL resource
   using SmartCURL = std::unique_ptr<CURL, decltype(&curl_easy_cleanup)>;
 };
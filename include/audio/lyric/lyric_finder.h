@@ -6,6 +6,7 @@
 #ifndef INCLUDE_AUDIO_LYRIC_LYRIC_FINDER_H_
 #define INCLUDE_AUDIO_LYRIC_LYRIC_FINDER_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -67,9 +68,11 @@ class LyricFinder {
    * @brief Search for lyrics by fetching the search engine and web scraping it
    * @param artist Artist name
    * @param title Song name
-   * @return Song lyrics
+   * @param cancelled Search must be aborted as soon as possible when set (by another thread)
+   * @return Song lyrics (empty if not found or cancelled)
    */
-  virtual SongLyric Search(const std::string& artist, const std::string& title);
+  virtual SongLyric Search(const std::string& artist, const std::string& title,
+                           const std::atomic<bool>& cancelled);
 
   /* ******************************************************************************************** */
   //! Variables
@@ -12,7 +12,6 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
-#include <optional>
 #include <thread>
 #include <vector>
 
@@ -48,7 +47,7 @@ class AudioControl {
   virtual ~AudioControl() = default;
 
   virtual void Play(const std::filesystem::path& filepath) = 0;
-  virtual void Play(const model::Playlist& playlist) = 0;
+  virtual void Play(const model::SharedPlaylist& playlist) = 0;
   virtual void PauseOrResume() = 0;
   virtual void Stop() = 0;
   virtual void SetAudioVolume(const model::Volume& value) = 0;
@@ -153,7 +152,7 @@ class Player : public AudioControl {
    * @brief Inform Audio loop to play the given playlist
    * @param playlist Song queue
    */
-  void Play(const model::Playlist& playlist) override;
+  void Play(const model::SharedPlaylist& playlist) override;
 
   /**
    * @brief Inform Audio loop to pause/resume song
@@ -361,8 +360,9 @@ class Player : public AudioControl {
 
   MediaControlSynced media_control_;  // Controls the media (play, pause/resume and stop)
 
-  std::unique_ptr<model::Song> curr_song_;        //!< Current song playing
-  std::optional<model::Playlist> curr_playlist_;  //!< Queue of songs (origined from playlist)
+  std::unique_ptr<model::Song> curr_song_;  //!< Current song playing
+  model::SharedPlaylist curr_playlist_;     //!< Queue of songs (origined from playlist)
+  size_t next_song_ = 0;                    //!< Index for next song to play from playlist
 
   std::weak_ptr<interface::Notifier> notifier_;  //!< Send notifications to interface
 
@@ -6,7 +6,10 @@
 #ifndef INCLUDE_DEBUG_DUMMY_ANALYZER_H_
 #define INCLUDE_DEBUG_DUMMY_ANALYZER_H_
 
+#include <atomic>
+
 #include "audio/base/analyzer.h"
+#include "audio/driver/spectrum_analyzer.h"
 #include "model/application_error.h"
 
 namespace driver {
@@ -46,7 +49,9 @@ class DummyAnalyzer : public Analyzer {
    * @param size Input vector size
    * @param out Output vector where each entry represents a frequency bar
    */
-  error::Code Execute(double *in, int size, double *out) override { return error::kSuccess; }
+  error::Code Execute(model::Sample *in, int size, model::Sample *out) override {
+    return error::kSuccess;
+  }
 
   /**
    * @brief Get internal buffer size
@@ -65,12 +70,12 @@ class DummyAnalyzer : public Analyzer {
   /* *********************************************************************************************/
   //! Default Constants
  private:
-  static constexpr int kBufferSize = 1024;  //!< Base size for buffers
+  static constexpr int kBufferSize = driver::SpectrumAnalyzer::kInputSize;  //!< Same as FFTW
 
   /* ******************************************************************************************** */
   //! Variables
  private:
-  int output_size_;  //!< Maximum output size from audio analysis
+  std::atomic<int> output_size_ = 0;  //!< Maximum output size from audio analysis
 };
 
 }  // namespace driver
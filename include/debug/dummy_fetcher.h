@@ -6,6 +6,7 @@
 #ifndef INCLUDE_DEBUG_DUMMY_FETCHER_H_
 #define INCLUDE_DEBUG_DUMMY_FETCHER_H_
 
+#include <atomic>
 #include <string>
 
 namespace driver {
@@ -32,9 +33,11 @@ class DummyFetcher : public UrlFetcher {
    * @brief Fetch content from the given URL
    * @param URL Endpoint address
    * @param output Output from fetch (out)
+   * @param cancelled Fetch must be aborted as soon as possible when set (by another thread)
    * @return Error code from operation
    */
-  error::Code Fetch(const std::string &URL, std::string &output) override {
+  error::Code Fetch(const std::string &URL, std::string &output,
+                    const std::atomic<bool> &cancelled) override {
     return error::kSuccess;
   }
 };
@@ -6,16 +6,21 @@
 #ifndef INCLUDE_MIDDLEWARE_MEDIA_CONTROLLER_H_
 #define INCLUDE_MIDDLEWARE_MEDIA_CONTROLLER_H_
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <thread>
 
 #include "audio/base/analyzer.h"
 #include "audio/base/notifier.h"
+#include "audio/driver/spectrum_analyzer.h"
 #include "audio/player.h"
 #include "model/application_error.h"
+#include "model/audio_spectrum.h"
 #include "model/song.h"
 #include "view/base/event_dispatcher.h"
 #include "view/base/notifier.h"
@@ -80,6 +85,13 @@ class MediaController : public audio::Notifier, public interface::Notifier {
    */
   void Exit();
 
+  /**
+   * @brief Set target frame rate for Audio Analysis, which is independent of the period size used
+   * by Audio Player to deliver raw audio data
+   * @param value Frames per second (clamped to a sane range)
+   */
+  void SetAnalysisRate(int value);
+
   /* ******************************************************************************************** */
   //! Internal operations
  private:
@@ -95,6 +107,12 @@ class MediaController : public audio::Notifier, public interface::Notifier {
    */
   void AnalysisHandler();
 
+  /**
+   * @brief Main-loop function to rebuild analyzer internal structures with a new output size, so
+   * that Audio Analysis does not get blocked while FFT plans are being created
+   */
+  void ResizeHandler();
+
   /* ******************************************************************************************** */
   //! Actions received from UI and sent to Player
  public:
@@ -148,7 +166,7 @@ class MediaController : public audio::Notifier, public interface::Notifier {
    * @brief Notify Audio Player about playlist selected by user on Terminal User Interface (TUI)
    * @param playlist Song queue
    */
-  void NotifyPlaylistSelection(const model::Playlist& playlist) override;
+  void NotifyPlaylistSelection(const model::SharedPlaylist& playlist) override;
 
   /* ******************************************************************************************** */
   //! Actions received from Player and sent to UI
@@ -192,7 +210,6 @@ class MediaController : public audio::Notifier, public interface::Notifier {
    */
   enum class Command {
     None = 10000,
-    Analyze = 10001,
     RunClearAnimationWithRegain = 10002,
     RunClearAnimationWithoutRegain = 10003,
     RunRegainAnimation = 10004,
@@ -209,25 +226,34 @@ class MediaController : public audio::Notifier, public interface::Notifier {
 
     std::queue<Command> queue;  //!< Queue with media control commands
 
-    std::vector<double> buffer;  //!< Input buffer with raw audio data
+    std::vector<model::Sample> buffer;  //!< Input buffer with raw audio data
 
     /**
-     * @brief Get a slice from raw audio data to run frequency analysis
+     * @brief Get a slice from raw audio data to run frequency analysis. In case that audio data got
+     * accumulated beyond what analyzer is able to handle, oldest samples are discarded, as there is
+     * no point in drawing frames that are already late
      *
-     * @param size Chunk size
-     * @return Vector containing raw audio data
+     * @param hop Chunk size to consume for a single frame
+     * @param limit Maximum size to keep in buffer before discarding old samples
+     * @param output Vector to fill with raw audio data
+     * @return Number of samples discarded
      */
-    std::vector<double> GetBuffer(int size) {
+    int GetFrame(int hop, int limit, std::vector<model::Sample>& output) {
       std::unique_lock lock(mutex);
-      if (size > buffer.size()) size = (int)buffer.size();
+      int discarded = 0;
 
-      std::vector<double>::const_iterator first = buffer.begin();
-      std::vector<double>::const_iterator last = buffer.begin() + size;
+      if (int size = (int)buffer.size(); size > limit) {
+        // Keep channels aligned, by always discarding an even number of samples
+        discarded = (size - limit) & ~1;
+        buffer.erase(buffer.begin(), buffer.begin() + discarded);
+      }
+
+      if (hop > (int)buffer.size()) hop = (int)buffer.size();
 
-      std::vector<double> output(first, last);
-      buffer.erase(first, last);
+      output.assign(buffer.begin(), buffer.begin() + hop);
+      buffer.erase(buffer.begin(), buffer.begin() + hop);
 
-      return output;
+      return discarded;
     }
 
     /**
@@ -238,11 +264,11 @@ class MediaController : public audio::Notifier, public interface::Notifier {
      */
     void Append(int* input, int size) {
       std::unique_lock lock(mutex);
-      std::vector<double>::const_iterator end = buffer.end();
+      std::vector<model::Sample>::const_iterator end = buffer.end();
 
       buffer.insert(end, input, input + size);
 
-      queue.push(Command::Analyze);
+      // Do not enqueue any command, analysis thread consumes this data on its own pace
       notifier.notify_one();
     }
 
@@ -276,56 +302,97 @@ class MediaController : public audio::Notifier, public interface::Notifier {
       return cmd;
     }
 
+    /**
+     * @brief Check if there is some command ready to be executed (must be called with lock held)
+     * @return True if queue contains a command to execute, otherwise false
+     */
+    bool HasCommand() const {
+      // No command in queue
+      if (queue.empty()) return false;
+
+      // Do not run regain animation while it has not received any input data from player
+      if (queue.size() == 1 && queue.front() == Command::RunRegainAnimation && buffer.empty())
+        return false;
+
+      return true;
+    }
+
     /**
      * @brief Block thread until player sends an event and media controller translate it into a
-     * command.
+     * command, or until it is time to analyze a new frame from raw audio data received so far.
+     * When there is no command in queue after unblocking, a new frame must be analyzed.
      *
+     * @param deadline Timestamp to analyze next frame
      * @return True if thread should keep working, False if not
      */
-    bool WaitForCommand() {
+    bool WaitForCommandOrFrame(const std::chrono::steady_clock::time_point& deadline) {
       std::unique_lock lock(mutex);
-      notifier.wait(lock, [this]() {
-        // No command in queue
-        if (queue.empty()) return false;
 
-        // Do not run regain animation while it has not received any input data from player
-        if (queue.size() == 1 && queue.front() == Command::RunRegainAnimation) return false;
+      // Block until there is something to do
+      notifier.wait(lock, [this]() { return HasCommand() || !buffer.empty(); });
 
-        return true;
-      });
+      // In case of having only audio data, wait for frame deadline (but commands are still welcome)
+      notifier.wait_until(lock, deadline, [this]() { return HasCommand(); });
 
-      return queue.front() != Command::Exit;
+      return queue.empty() || queue.front() != Command::Exit;
     }
+  };
+
+  /**
+   * @brief An structure for data synchronization regarding resize requests from UI (only the most
+   * recent requested size is kept, as intermediate values are useless)
+   */
+  struct ResizeDataSynced {
+    std::mutex mutex;                  //!< Control access for internal resources
+    std::condition_variable notifier;  //!< Conditional variable to block thread
+
+    std::optional<int> output_size;  //!< Most recent output size requested
+    bool exit = false;               //!< Flag to exit from resize thread
 
     /**
-     * @brief Block thread until player sends a command or reaches timeout
-     * @param timeout Timestamp deadline
-     *
-     * @return True if thread unlocked by command, False if reached timeout
+     * @brief Push new output size, discarding any other request that was not processed yet
+     * @param value Output size
      */
-    bool WaitForCommandOrUntil(
-        const std::chrono::time_point<std::chrono::system_clock,
-                                      std::chrono::duration<long double, std::nano>>& timeout) {
+    void Push(int value) {
       std::unique_lock lock(mutex);
-      notifier.wait_until(lock, timeout, [this]() {
-        // No command in queue
-        if (queue.empty()) return false;
+      output_size = value;
+      notifier.notify_one();
+    }
 
-        return true;
-      });
+    /**
+     * @brief Notify resize thread to exit
+     */
+    void Exit() {
+      std::unique_lock lock(mutex);
+      exit = true;
+      notifier.notify_one();
+    }
+
+    /**
+     * @brief Block thread until some resize request is received
+     * @return Output size requested, or empty in case that thread should stop working
+     */
+    std::optional<int> WaitForRequest() {
+      std::unique_lock lock(mutex);
+      notifier.wait(lock, [this]() { return exit || output_size.has_value(); });
 
-      return !queue.empty();
+      if (exit) return std::nullopt;
+
+      auto value = output_size;
+      output_size.reset();
+
+      return value;
     }
   };
 
   /* ******************************************************************************************** */
   //! Audio visualizer animation
 
-  //! Execute clear animation based on the most recent analyzed data
-  void ProcessClearAnimation(std::vector<double>& data);
+  //! Execute clear animation, by sending lowest values as target for spectrum visualizer bars
+  void ProcessClearAnimation(int size);
 
-  //! Execute regain animation based on old data from before the clear animation
-  void ProcessRegainAnimation(const std::vector<double>& data);
+  //! Execute regain animation, by sending data from before the clear animation as target for bars
+  void ProcessRegainAnimation(const model::AudioSpectrum& data);
 
   /* ******************************************************************************************** */
   //! Utility
@@ -340,9 +407,36 @@ class MediaController : public audio::Notifier, public interface::Notifier {
 
   std::unique_ptr<driver::Analyzer> analyzer_;  //!< Run FFTs on audio raw data to get spectrum
 
+  //! Frames shared with spectrum visualizer (events only notify that a new frame is available)
+  std::shared_ptr<model::SharedSpectrum> spectrum_ = std::make_shared<model::SharedSpectrum>();
+
   std::thread analysis_loop_;  //!< Execute audio-analysis function as a thread
+  std::thread resize_loop_;    //!< Execute analyzer resize function as a thread
 
   AnalysisDataSynced sync_data_;  //!< Controls the audio data synchronization
+  ResizeDataSynced resize_data_;  //!< Controls the resize requests synchronization
+
+  std::atomic<int> analysis_rate_ = kDefaultAnalysisRate;  //!< Target frames per second
+
+  /* ******************************************************************************************** */
+  //! Constants
+
+  static constexpr int kDefaultAnalysisRate = 30;  //!< Default target frames per second
+  static constexpr int kMinAnalysisRate = 15;      //!< Minimum target frames per second
+  static constexpr int kMaxAnalysisRate = 240;     //!< Maximum target frames per second
+
+  static constexpr int kSampleRate = 44100;  //!< Sample rate from raw audio data sent by Player
+  static constexpr int kNumberChannels = 2;  //!< Number of channels from raw audio data
+  static constexpr int kMaxPendingFrames = 4;  //!< Frames to accumulate before discarding audio
+
+  //! Audio data consumed per frame at the lowest rate must fit in the analyzer input, otherwise
+  //! every frame would be clamped and the backlog discarded continuously
+  static_assert(kSampleRate * kNumberChannels / kMinAnalysisRate <=
+                    driver::SpectrumAnalyzer::kInputSize,
+                "Minimum analysis rate does not fit in analyzer input");
+
+  //! Interval to report real analysis frame rate
+  static constexpr std::chrono::seconds kRateReportInterval{10};
 
   /* ******************************************************************************************** */
   //! Friend class for testing purpose
@@ -0,0 +1,32 @@
+/**
+ * \file
+ * \brief  Data types used by audio analysis
+ */
+
+#ifndef INCLUDE_MODEL_AUDIO_SPECTRUM_H_
+#define INCLUDE_MODEL_AUDIO_SPECTRUM_H_
+
+#include <vector>
+
+#include "util/triple_buffer.h"
+
+namespace model {
+
+/**
+ * @brief Floating-point type used by the whole audio analysis chain, from raw audio samples up to
+ * the frequency bars rendered by the spectrum visualizer (selected at build time)
+ */
+#ifdef SPECTRUM_FFTW_FLOAT
+using Sample = float;
+#else
+using Sample = double;
+#endif
+
+//! Audio spectrum (each entry represents a frequency bar)
+using AudioSpectrum = std::vector<Sample>;
+
+//! Audio spectrum frames shared between audio analysis (writer) and spectrum visualizer (reader)
+using SharedSpectrum = util::TripleBuffer<AudioSpectrum>;
+
+}  // namespace model
+#endif  // INCLUDE_MODEL_AUDIO_SPECTRUM_H_
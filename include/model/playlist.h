@@ -7,6 +7,7 @@
 #define INCLUDE_MODEL_PLAYLIST_H_
 
 #include <deque>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -46,5 +47,8 @@ struct Playlist {
 
 using Playlists = std::vector<Playlist>;
 
+//! Read-only playlist, shared between threads without copying its songs
+using SharedPlaylist = std::shared_ptr<const Playlist>;
+
 }  // namespace model
 #endif  // INCLUDE_MODEL_PLAYLIST_H_
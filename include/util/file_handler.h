@@ -6,16 +6,254 @@
 #ifndef INCLUDE_UTIL_FILE_HANDLER_H_
 #define INCLUDE_UTIL_FILE_HANDLER_H_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "model/playlist.h"
 
+#ifdef ENABLE_TESTS
+namespace {
+class SidebarTest;
+}
+#endif
+
 namespace util {
 
 //! For better readability
 using File = std::filesystem::path;  //!< Single file path
-using Files = std::vector<File>;     //!< List of file paths
+
+/**
+ * @brief Entry listed from a directory, caching everything already known about the file while
+ * listing it (so there is no need to query the filesystem again on every render)
+ */
+struct FileEntry {
+  File path;                                                              //!< File path
+  std::string sort_key = {};                                              //!< Key to sort by name
+  std::filesystem::file_type type = std::filesystem::file_type::unknown;  //!< File type
+  std::uintmax_t size = 0;                        //!< File size in bytes (only for regular files)
+  std::filesystem::file_time_type modified = {};  //!< Last modification time
+
+  //! Check if entry is a directory (or a symlink to one)
+  bool IsDirectory() const { return type == std::filesystem::file_type::directory; }
+
+  // For comparisons
+  friend bool operator==(const FileEntry& lhs, const FileEntry& rhs) {
+    return lhs.path == rhs.path;
+  }
+  friend bool operator!=(const FileEntry& lhs, const FileEntry& rhs) { return !(lhs == rhs); }
+};
+
+using Files = std::vector<FileEntry>;  //!< List of file entries
+
+/**
+ * @brief Create key to sort a file by its name (case insensitive and ignoring hidden prefix,
+ * similar to "ls"). Any sequence of digits is compared by its numeric value, so "Track 2" comes
+ * before "Track 10". It is computed only once per entry, so sorting does not allocate strings.
+ * @param path File path
+ * @return Sort key
+ */
+std::string make_sort_key(const File& path);
+
+/**
+ * @brief Sort order for listed files, using their precomputed sort keys
+ * @param a File entry a
+ * @param b File entry b
+ * @return true if 'a' is alphabetically lesser than b, false otherwise
+ */
+bool sort_files(const FileEntry& a, const FileEntry& b);
+
+/* ********************************************************************************************** */
+
+/**
+ * @brief List files from a directory in a background thread, so a huge (or slow) directory does
+ * not block the caller. Files are collected in sorted batches, and listing is cancelled as soon as
+ * this object is destroyed.
+ */
+class DirectoryListing {
+ public:
+  //! Callback to notify that new entries are available (called from listing thread)
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Construct a new DirectoryListing object (and spawn its thread)
+   * @param iterator Iterator for directory already opened
+   * @param notify Callback to notify about new entries available
+   */
+  DirectoryListing(std::filesystem::directory_iterator iterator, const Callback& notify);
+
+  /**
+   * @brief Destroy the DirectoryListing object (cancelling listing, if still running)
+   */
+  ~DirectoryListing();
+
+  //! Remove these
+  DirectoryListing(const DirectoryListing& other) = delete;             // copy constructor
+  DirectoryListing(DirectoryListing&& other) = delete;                  // move constructor
+  DirectoryListing& operator=(const DirectoryListing& other) = delete;  // copy assignment
+  DirectoryListing& operator=(DirectoryListing&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Wait for listing to finish within the given timeout. If it does not, from now on, every
+   * new batch of entries is notified through callback
+   * @param timeout Maximum time to wait
+   * @return true if listing has finished, false otherwise
+   */
+  bool WaitFor(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Take every entry listed since last call
+   * @param entries[out] New entries (already sorted)
+   * @return true if listing has finished (so there is nothing else to take), false otherwise
+   */
+  bool Consume(Files& entries);
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  //! Shared between this object and listing thread (which may outlive it while cancelling)
+  struct State {
+    std::mutex mutex;                    //!< Control access for internal state
+    std::condition_variable notifier;    //!< Notify when listing has finished
+    std::atomic<bool> cancelled{false};  //!< Listing must stop as soon as possible
+    bool finished = false;               //!< Directory was completely listed
+    bool notify_enabled = false;         //!< Notify caller about every new batch
+    Callback notify;                     //!< Notify about new entries available
+    Files pending;                       //!< Entries listed but not taken yet
+  };
+
+  /**
+   * @brief Thread to iterate through directory entries, sorting them in batches
+   * @param iterator Iterator for directory already opened
+   * @param state Internal state
+   */
+  static void ListingHandler(std::filesystem::directory_iterator iterator,
+                             std::shared_ptr<State> state);
+
+  /**
+   * @brief Merge a batch of entries into pending entries
+   * @param batch Entries listed (will be sorted)
+   * @param finished Directory was completely listed
+   * @param state Internal state
+   */
+  static void Deliver(Files& batch, bool finished, State& state);
+
+  /* ******************************************************************************************** */
+  //! Constants
+ public:
+  static constexpr size_t kMaxBatchSize = 512;  //!< Maximum entries before delivering a batch
+
+  //! Maximum time to wait before delivering a batch
+  static constexpr std::chrono::milliseconds kBatchInterval{50};
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::shared_ptr<State> state_;  //!< Internal state
+};
+
+/* ********************************************************************************************** */
+
+/**
+ * @brief Watch a directory (using inotify) for entries created, deleted, renamed or rewritten, so
+ * the caller can update its list of files incrementally, instead of listing directory again.
+ * Events are collected in a background thread and coalesced, so caller is notified at most once
+ * per interval, even for a burst of thousands of events (like copying a whole album into it).
+ */
+class DirectoryWatcher {
+ public:
+  //! Callback to notify that new changes are available (called from watching thread)
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Construct a new DirectoryWatcher object (and spawn its thread)
+   * @param dir_path Full path to directory
+   * @param descriptor Inotify instance already watching directory (owned by this object)
+   * @param notify Callback to notify about new changes available
+   */
+  DirectoryWatcher(const std::filesystem::path& dir_path, int descriptor, const Callback& notify);
+
+  /**
+   * @brief Destroy the DirectoryWatcher object (stopping its thread)
+   */
+  ~DirectoryWatcher();
+
+  //! Remove these
+  DirectoryWatcher(const DirectoryWatcher& other) = delete;             // copy constructor
+  DirectoryWatcher(DirectoryWatcher&& other) = delete;                  // move constructor
+  DirectoryWatcher& operator=(const DirectoryWatcher& other) = delete;  // copy assignment
+  DirectoryWatcher& operator=(DirectoryWatcher&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Take every change since last call. An entry modified is reported as both removed and
+   * added, so caller only needs to remove entries first and then add the new ones
+   * @param added[out] Entries created (or modified) in directory
+   * @param removed[out] Entries deleted (or modified) from directory
+   * @return true if some events were lost (so directory must be listed again), false otherwise
+   */
+  bool Consume(Files& added, std::vector<File>& removed);
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  //! Shared between this object and watching thread (which may outlive it while stopping)
+  struct State {
+    std::mutex mutex;                    //!< Control access for internal state
+    std::atomic<bool> cancelled{false};  //!< Watching must stop as soon as possible
+    int inotify = -1;                    //!< Inotify instance watching directory
+    int wakeup = -1;                     //!< Event to wake up thread when cancelled
+    bool overflow = false;               //!< Some events were lost
+    Callback notify;                     //!< Notify about new changes available
+
+    //! Latest state for each entry changed and not taken yet, by its full path (empty if it does
+    //! not exist anymore)
+    std::unordered_map<std::string, std::optional<FileEntry>> pending;
+
+    ~State();
+  };
+
+  /**
+   * @brief Thread to read events from inotify, delivering them in batches
+   * @param dir_path Full path to directory
+   * @param state Internal state
+   */
+  static void WatchingHandler(std::filesystem::path dir_path, std::shared_ptr<State> state);
+
+  /* ******************************************************************************************** */
+  //! Constants
+ public:
+  //! Time to keep collecting events after the first one, before notifying caller
+  static constexpr std::chrono::milliseconds kCoalesceInterval{100};
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::shared_ptr<State> state_;  //!< Internal state
+
+  /* ******************************************************************************************** */
+  //! Friend class for testing purpose
+
+#ifdef ENABLE_TESTS
+  friend class ::SidebarTest;
+#endif
+};
+
+/* ********************************************************************************************** */
 
 /**
  * @brief Class responsible to perform any file I/O operation
@@ -53,6 +291,18 @@ class FileHandler {
    */
   std::string GetPlaylistsPath() const;
 
+  /**
+   * @brief Get full path to FFTW wisdom file (used to cache FFTW plans between executions)
+   * @return String containing filepath
+   */
+  std::string GetFftwWisdomPath() const;
+
+  /**
+   * @brief Get full path to library index file (used to search files from the whole library)
+   * @return String containing filepath
+   */
+  std::string GetLibraryIndexPath() const;
+
   /**
    * @brief List all files from the given directory path
    * @param dir_path Full path to directory
@@ -61,6 +311,25 @@ class FileHandler {
    */
   bool ListFiles(const std::filesystem::path& dir_path, Files& parsed_files);
 
+  /**
+   * @brief Start listing all files from the given directory path in a background thread (the
+   * option to go back one level is not listed)
+   * @param dir_path Full path to directory
+   * @param notify Callback to notify about new entries available
+   * @return Listing in progress, or nullptr if directory cannot be accessed
+   */
+  std::unique_ptr<DirectoryListing> ListFilesAsync(const std::filesystem::path& dir_path,
+                                                   const DirectoryListing::Callback& notify);
+
+  /**
+   * @brief Start watching the given directory path for changes in its entries
+   * @param dir_path Full path to directory
+   * @param notify Callback to notify about new changes available
+   * @return Watcher running, or nullptr if directory cannot be watched
+   */
+  std::unique_ptr<DirectoryWatcher> WatchDirectory(const std::filesystem::path& dir_path,
+                                                   const DirectoryWatcher::Callback& notify);
+
   /**
    * @brief Parse playlists from JSON
    * @param playlists[out] Playlists object filled by data from JSON parsed
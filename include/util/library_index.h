@@ -0,0 +1,193 @@
+/**
+ * \file
+ * \brief  Class for searching any file path under a root directory (using a trigram index)
+ */
+
+#ifndef INCLUDE_UTIL_LIBRARY_INDEX_H_
+#define INCLUDE_UTIL_LIBRARY_INDEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "util/file_handler.h"
+
+namespace util {
+
+/**
+ * @brief Index with every file path under a root directory (like a whole music library), to search
+ * for a text in any of them (case insensitive). It is built in a background thread and saved to
+ * disk, so on the next execution it is available right away, while a new scan reuses every
+ * directory not modified since then (so only changed directories are listed again).
+ *
+ * Each trigram (sequence of three characters) is mapped to the directories whose relative path
+ * contains it and to the files whose name contains it, so a search only looks at paths containing
+ * the rarest trigram from text, instead of every path under root directory.
+ */
+class LibraryIndex {
+ public:
+  //! Callback to notify that a new index is available (called from indexing thread)
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Construct a new LibraryIndex object (and spawn its thread)
+   * @param root Root directory to index
+   * @param cache_path Full path to file where index is saved
+   * @param notify Callback to notify about new index available
+   */
+  LibraryIndex(const std::filesystem::path& root, const std::filesystem::path& cache_path,
+               const Callback& notify);
+
+  /**
+   * @brief Destroy the LibraryIndex object (cancelling scan, if still running)
+   */
+  ~LibraryIndex();
+
+  //! Remove these
+  LibraryIndex(const LibraryIndex& other) = delete;             // copy constructor
+  LibraryIndex(LibraryIndex&& other) = delete;                  // move constructor
+  LibraryIndex& operator=(const LibraryIndex& other) = delete;  // copy assignment
+  LibraryIndex& operator=(LibraryIndex&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Find every file whose path (relative to root directory) contains the given text
+   * @param text Text to search for (case insensitive)
+   * @param max_results Maximum number of files to return
+   * @return Full path to files found, in the same order as listed in directories
+   */
+  std::vector<File> Search(std::string_view text, size_t max_results = kMaxResults) const;
+
+  /**
+   * @brief Scan root directory again in background (if not scanning it already), reusing every
+   * directory not modified since last scan
+   */
+  void Update();
+
+  //! Get root directory
+  const std::filesystem::path& GetRoot() const { return root_; }
+
+  //! Check if scan is still running (so index may be missing or outdated)
+  bool IsUpdating() const { return state_->updating; }
+
+  //! Get counter incremented for every new index available (to know when to search again)
+  int GetVersion() const { return state_->version; }
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  //! Map trigram to identifiers (sorted) from directories or files containing it
+  using Postings = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+  //! Single directory under root, with names from its entries
+  struct Directory {
+    std::string path;                  //!< Path relative to root (empty for root itself)
+    int64_t modified = 0;              //!< Last modification time
+    std::vector<std::string> files;    //!< Name of each regular file (sorted)
+    std::vector<std::string> subdirs;  //!< Name of each subdirectory (sorted)
+  };
+
+  //! Immutable index, shared between searches and indexing thread
+  struct Snapshot {
+    //! Every directory, in depth-first order (shared with previous index, if not modified since)
+    std::vector<std::shared_ptr<const Directory>> directories;
+
+    std::vector<uint32_t> first_file;  //!< Identifier of first file from each directory (+ total)
+    Postings directory_postings;       //!< Directories whose path contains trigram
+    Postings file_postings;            //!< Files whose name contains trigram
+    std::vector<uint64_t> file_masks;  //!< Characters contained in each file name (one bit each)
+  };
+
+  //! Shared between this object and indexing thread (which may outlive it while cancelling)
+  struct State {
+    std::mutex mutex;                          //!< Control access for internal state
+    std::atomic<bool> cancelled{false};        //!< Scan must stop as soon as possible
+    std::atomic<bool> updating{true};          //!< Scan is still running
+    std::atomic<int> version{0};               //!< Counter for new index published
+    Callback notify;                           //!< Notify about new index available
+    std::shared_ptr<const Snapshot> snapshot;  //!< Latest index available
+  };
+
+  /**
+   * @brief Thread to scan root directory and update index (loading it from disk on first scan)
+   * @param root Root directory to index
+   * @param cache_path Full path to file where index is saved
+   * @param state Internal state
+   */
+  static void IndexHandler(std::filesystem::path root, std::filesystem::path cache_path,
+                           std::shared_ptr<State> state);
+
+  /**
+   * @brief Scan every directory under root, reusing those not modified since previous scan
+   * @param root Root directory to index
+   * @param previous Index from previous scan (may be null)
+   * @param cancelled Scan must stop as soon as possible
+   * @param changed[out] Any directory was added, modified or removed since previous scan
+   * @return New index (without trigrams), or null if cancelled
+   */
+  static std::shared_ptr<Snapshot> Scan(const std::filesystem::path& root, const Snapshot* previous,
+                                        const std::atomic<bool>& cancelled, bool& changed);
+
+  /**
+   * @brief Fill first file identifiers, trigrams and masks for all directories in index, reusing
+   * them from previous index for every leading directory shared with it (as their identifiers are
+   * the same in both)
+   * @param snapshot Index to update
+   * @param previous Index from previous scan (may be null)
+   */
+  static void BuildPostings(Snapshot& snapshot, const Snapshot* previous);
+
+  /**
+   * @brief Load index from disk
+   * @param cache_path Full path to file where index is saved
+   * @param root Root directory expected in file
+   * @return Index loaded, or null if file is missing, invalid or belongs to another root directory
+   */
+  static std::shared_ptr<Snapshot> Load(const std::filesystem::path& cache_path,
+                                        const std::filesystem::path& root);
+
+  /**
+   * @brief Save index to disk (written to a temporary file first, so it is never left incomplete)
+   * @param snapshot Index to save
+   * @param cache_path Full path to file where index is saved
+   * @param root Root directory indexed
+   * @return true if index was saved succesfully, false otherwise
+   */
+  static bool Save(const Snapshot& snapshot, const std::filesystem::path& cache_path,
+                   const std::filesystem::path& root);
+
+  /**
+   * @brief Publish a new index, making it available for searches
+   * @param snapshot Index to publish
+   * @param state Internal state
+   */
+  static void Publish(std::shared_ptr<const Snapshot> snapshot, State& state);
+
+  /* ******************************************************************************************** */
+  //! Constants
+ public:
+  static constexpr size_t kMaxResults = 500;  //!< Default maximum number of results
+
+ private:
+  static constexpr uint32_t kFileMagic = 0x494C5053;  //!< Identifier for index file ("SPLI")
+  static constexpr uint32_t kFileVersion = 1;         //!< Format version for index file
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::filesystem::path root_;        //!< Root directory
+  std::filesystem::path cache_path_;  //!< Full path to file where index is saved
+  std::shared_ptr<State> state_;      //!< Internal state
+};
+
+}  // namespace util
+#endif  // INCLUDE_UTIL_LIBRARY_INDEX_H_
@@ -0,0 +1,95 @@
+/**
+ * \file
+ * \brief  Class for case-insensitive fuzzy search over a list of entry names
+ */
+
+#ifndef INCLUDE_UTIL_SEARCH_INDEX_H_
+#define INCLUDE_UTIL_SEARCH_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief Index to search for a text in a list of entry names (case insensitive), using fuzzy
+ * matching similar to fzf: an entry matches when every character from text appears in its name in
+ * the same order, and it is scored higher when these characters are consecutive or at the start of
+ * a word. Every name is lowercased only once, when added to index, and stored in a single
+ * contiguous buffer, along with a bitmask of the characters it contains (so most entries are
+ * discarded without even looking at their names). Entries matching last search are kept, so when a
+ * query is extended (like when typing a new character), only these entries are searched again.
+ */
+class SearchIndex {
+ public:
+  /**
+   * @brief Remove all entries from index
+   */
+  void Clear();
+
+  /**
+   * @brief Append a new entry to index (its position is the index returned by Filter)
+   * @param name Entry name
+   */
+  void Add(std::string_view name);
+
+  /**
+   * @brief Get total of entries in index
+   * @return Index size
+   */
+  int Size() const { return static_cast<int>(offsets_.size()) - 1; }
+
+  /**
+   * @brief Find entries matching the given text
+   * @param text Text to search for (an empty text matches every entry, keeping their order)
+   * @param max_results Maximum number of entries to return (ignored for an empty text)
+   * @return Indexes of the best entries matching text, sorted by score (and then by index)
+   */
+  const std::vector<int>& Filter(std::string_view text, size_t max_results = kMaxResults);
+
+  /**
+   * @brief Calculate score for name matching the given query (both must be already in lowercase)
+   * @param name Entry name
+   * @param query Text to search for
+   * @return Score (the higher, the better), or kNoMatch if name does not match query
+   */
+  static int Score(std::string_view name, std::string_view query);
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  //! Get bitmask with all characters contained in text
+  static uint64_t GetMask(std::string_view text);
+
+  /* ******************************************************************************************** */
+  //! Constants
+ public:
+  static constexpr size_t kMaxResults = 1000;  //!< Default maximum number of results
+  static constexpr int kNoMatch = -1;          //!< Score for names not matching query
+
+  static constexpr int kScoreMatch = 16;               //!< Score for each character matched
+  static constexpr int kScoreGapStart = -3;            //!< Penalty for starting a gap in match
+  static constexpr int kScoreGapExtension = -1;        //!< Penalty for each character in a gap
+  static constexpr int kBonusBoundary = 8;             //!< Bonus for match at the start of a word
+  static constexpr int kBonusConsecutive = 4;          //!< Bonus for consecutive characters
+  static constexpr int kBonusFirstCharMultiplier = 2;  //!< Multiplier for bonus on first character
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::string buffer_;              //!< Lowercase names from all entries, one after another
+  std::vector<size_t> offsets_{0};  //!< Offset of each name in buffer (plus end of the last one)
+  std::vector<uint64_t> masks_;     //!< Characters contained in each name
+
+  bool cached_ = false;                      //!< Results below are valid for the current entries
+  std::string query_;                        //!< Last text searched (in lowercase)
+  std::vector<int> candidates_;              //!< Every entry matching last text searched
+  std::vector<std::pair<int, int>> scored_;  //!< Score and index for each candidate
+  std::vector<int> results_;                 //!< Best entries matching last text searched
+};
+
+}  // namespace util
+#endif  // INCLUDE_UTIL_SEARCH_INDEX_H_
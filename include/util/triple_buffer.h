@@ -0,0 +1,100 @@
+/**
+ * \file
+ * \brief  Class for lock-free data exchange between a single writer and a single reader
+ */
+
+#ifndef INCLUDE_UTIL_TRIPLE_BUFFER_H_
+#define INCLUDE_UTIL_TRIPLE_BUFFER_H_
+
+#include <array>
+#include <atomic>
+
+namespace util {
+
+/**
+ * @brief Triple buffer, where writer and reader own a buffer each and the third one holds the most
+ * recent data published by writer. Buffers are only exchanged (never allocated nor copied), so
+ * writer never waits for reader and reader always gets the latest data, skipping any other data
+ * that was published in the meantime.
+ *
+ * P.S.: Only a single thread must write into it, and only a single thread must read from it.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /**
+   * @brief Create a new TripleBuffer object
+   */
+  TripleBuffer() = default;
+
+  /**
+   * @brief Destroy the TripleBuffer object
+   */
+  ~TripleBuffer() = default;
+
+  //! Remove these
+  TripleBuffer(const TripleBuffer& other) = delete;             // copy constructor
+  TripleBuffer(TripleBuffer&& other) = delete;                  // move constructor
+  TripleBuffer& operator=(const TripleBuffer& other) = delete;  // copy assignment
+  TripleBuffer& operator=(TripleBuffer&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Writer API
+
+  /**
+   * @brief Get buffer owned by writer, to fill it before publishing
+   * @return Back buffer
+   */
+  T& GetBackBuffer() { return buffers_[back_]; }
+
+  /**
+   * @brief Publish data from back buffer, which becomes the most recent data available to reader
+   */
+  void Publish() { back_ = middle_.exchange(back_ | kNewData, std::memory_order_acq_rel) & kIndex; }
+
+  /**
+   * @brief Copy data into back buffer and publish it (when T is a container, its previous
+   * capacity is reused, so there is no allocation once buffers have grown enough)
+   * @param value Data to publish
+   */
+  void Publish(const T& value) {
+    buffers_[back_] = value;
+    Publish();
+  }
+
+  /* ******************************************************************************************** */
+  //! Reader API
+
+  /**
+   * @brief Acquire the most recent data published by writer (if any) as front buffer
+   * @return true if front buffer got updated, otherwise false
+   */
+  bool Update() {
+    if ((middle_.load(std::memory_order_acquire) & kNewData) == 0) return false;
+
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+    return true;
+  }
+
+  /**
+   * @brief Get buffer owned by reader (it is safe to modify or even swap its content, as it is
+   * only handed back to writer after next update)
+   * @return Front buffer
+   */
+  T& GetFrontBuffer() { return buffers_[front_]; }
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  static constexpr int kIndex = 0b011;    //!< Mask to get buffer index
+  static constexpr int kNewData = 0b100;  //!< Flag to indicate that middle buffer has new data
+
+  std::array<T, 3> buffers_;  //!< Buffers exchanged between writer and reader
+
+  int back_ = 0;                //!< Index for buffer owned by writer
+  std::atomic<int> middle_{1};  //!< Index for buffer holding the latest data (plus new data flag)
+  int front_ = 2;               //!< Index for buffer owned by reader
+};
+
+}  // namespace util
+#endif  // INCLUDE_UTIL_TRIPLE_BUFFER_H_
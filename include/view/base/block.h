@@ -58,6 +58,19 @@ class Block : public std::enable_shared_from_this<Block>, public ftxui::Componen
   //! Get focus state
   bool IsFocused() const { return focused_; }
 
+  //! Mark block content as changed, so it is rendered again on next frame
+  void SetDirty() { dirty_ = true; }
+
+  //! Check if block content may have changed since its last render
+  bool IsDirty() const { return dirty_; }
+
+  /**
+   * @brief Render block only if it is dirty, otherwise reuse element from its last render (layout
+   * is still computed by screen on every frame, so only the element tree building is skipped)
+   * @return Element Block element
+   */
+  ftxui::Element RenderCached();
+
  protected:
   //! Get decorator style for title based on internal state
   ftxui::Decorator GetTitleDecorator() const;
@@ -86,6 +99,13 @@ class Block : public std::enable_shared_from_this<Block>, public ftxui::Componen
     // This method is called whenever block loses focus
   }
 
+  /**
+   * @brief Check if custom event received by block may change its content, so it must be rendered
+   * again (as default, any event does it, so derived class should only filter out frequent events)
+   * @return true if block must be rendered again, otherwise false
+   */
+  virtual bool IsAffectedBy(const CustomEvent&) const { return true; }
+
   /* ******************************************************************************************** */
   //! Used by derived class
  protected:
@@ -99,6 +119,9 @@ class Block : public std::enable_shared_from_this<Block>, public ftxui::Componen
   model::BlockIdentifier id_;                  //!< Block identification
   Size size_;                                  //!< Block size
   bool focused_ = false;  //!< Control flag for focus state, to help with UI navigation
+
+  bool dirty_ = true;     //!< Control flag to render block again on next frame
+  ftxui::Element cache_;  //!< Element from last render
 };
 
 }  // namespace interface
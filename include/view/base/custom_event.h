@@ -7,10 +7,13 @@
 #define INCLUDE_VIEW_BASE_CUSTOM_EVENT_H_
 
 #include <filesystem>
+#include <memory>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 #include "model/audio_filter.h"
+#include "model/audio_spectrum.h"
 #include "model/bar_animation.h"
 #include "model/block_identifier.h"
 #include "model/playlist.h"
@@ -85,9 +88,10 @@ struct CustomEvent {
   //! Possible events (from audio thread to interface)
   static CustomEvent ClearSongInfo();
   static CustomEvent UpdateVolume(const model::Volume& sound_volume);
-  static CustomEvent UpdateSongInfo(const model::Song& info);
+  static CustomEvent UpdateSongInfo(model::Song info);
   static CustomEvent UpdateSongState(const model::Song::CurrentInformation& new_state);
-  static CustomEvent DrawAudioSpectrum(const std::vector<double>& data);
+  static CustomEvent DrawAudioSpectrum(const model::AudioSpectrum& data);
+  static CustomEvent DrawAudioSpectrum(const std::shared_ptr<model::SharedSpectrum>& frames);
 
   //! Possible events (from interface to audio thread)
   static CustomEvent NotifyFileSelection(const std::filesystem::path& file_path);
@@ -97,8 +101,8 @@ struct CustomEvent {
   static CustomEvent ResizeAnalysis(int bars);
   static CustomEvent SeekForwardPosition(int offset);
   static CustomEvent SeekBackwardPosition(int offset);
-  static CustomEvent ApplyAudioFilters(const model::EqualizerPreset& filters);
-  static CustomEvent NotifyPlaylistSelection(const model::Playlist& playlist);
+  static CustomEvent ApplyAudioFilters(model::EqualizerPreset filters);
+  static CustomEvent NotifyPlaylistSelection(model::Playlist playlist);
 
   //! Possible events (from interface to interface)
   static CustomEvent Refresh();
@@ -116,31 +120,71 @@ struct CustomEvent {
   static CustomEvent SkipToNextSong();
   static CustomEvent SkipToPreviousSong();
   static CustomEvent ShowPlaylistManager(const model::PlaylistOperation& operation);
-  static CustomEvent SavePlaylistsToFile(const model::Playlist& changed_playlist);
-  static CustomEvent ShowQuestionDialog(const model::QuestionData& data);
+  static CustomEvent SavePlaylistsToFile(model::Playlist changed_playlist);
+  static CustomEvent ShowQuestionDialog(model::QuestionData data);
 
   static CustomEvent Exit();
 
+  //! Heavy content is shared (and immutable), so copying an event never makes a deep copy of it
+  template <typename T>
+  using Shared = std::shared_ptr<const T>;
+
   //! Possible types for content
   using Content =
-      std::variant<std::monostate, model::Song, model::Volume, model::Song::CurrentInformation,
-                   std::filesystem::path, std::vector<double>, int, model::EqualizerPreset,
-                   model::BarAnimation, model::BlockIdentifier, model::Playlist,
-                   model::PlaylistOperation, model::QuestionData>;
+      std::variant<std::monostate, Shared<model::Song>, model::Volume,
+                   model::Song::CurrentInformation, std::filesystem::path, model::AudioSpectrum,
+                   std::shared_ptr<model::SharedSpectrum>, int, Shared<model::EqualizerPreset>,
+                   model::BarAnimation, model::BlockIdentifier, Shared<model::Playlist>,
+                   model::PlaylistOperation, Shared<model::QuestionData>>;
 
   //! Getter for event identifier
   Identifier GetId() const { return id; }
 
-  //! Generic getter for event content
+  /**
+   * @brief Generic getter for event content, returning a copy of it (prefer GetContentRef or
+   * GetSharedContent for heavy types, like model::Song or model::Playlist)
+   * @return Event content (or default-constructed value, if content holds another type)
+   */
   template <typename T>
   T GetContent() const {
-    if (std::holds_alternative<T>(content)) {
-      return std::get<T>(content);
+    return GetContentRef<T>();
+  }
+
+  /**
+   * @brief Generic getter for event content, without copying it
+   * @return Reference to event content (or to a default-constructed value, if content holds another
+   * type), valid as long as this event exists
+   */
+  template <typename T>
+  const T& GetContentRef() const {
+    if constexpr (IsShared<T>(static_cast<const Content*>(nullptr))) {
+      if (auto ptr = std::get_if<Shared<T>>(&content); ptr != nullptr && *ptr) return **ptr;
+    } else {
+      if (auto ptr = std::get_if<T>(&content); ptr != nullptr) return *ptr;
     }
 
-    return T();
+    static const T kEmpty{};
+    return kEmpty;
+  }
+
+  /**
+   * @brief Getter for heavy event content, to keep it after event is gone without copying it
+   * @return Pointer to event content (or nullptr, if content holds another type)
+   */
+  template <typename T>
+  Shared<T> GetSharedContent() const {
+    if (auto ptr = std::get_if<Shared<T>>(&content); ptr != nullptr) return *ptr;
+    return nullptr;
+  }
+
+ private:
+  //! Check if content type is held by a shared pointer (argument is only used for deduction)
+  template <typename T, typename... Types>
+  static constexpr bool IsShared(const std::variant<Types...>*) {
+    return (std::is_same_v<Shared<T>, Types> || ...);
   }
 
+ public:
   //! Variables
   // P.S. removed private keyword, otherwise wouldn't be possible to use C++ brace initialization
   Type type;        //!< Event group type
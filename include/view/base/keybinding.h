@@ -46,6 +46,7 @@ struct Navigation {
   static Key Close;
 
   static Key EnableSearch;
+  static Key EnableGlobalSearch;
 };
 
 /* ********************************************************************************************** */
@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \brief  Class to schedule screen redraws at a limited frame rate
+ */
+
+#ifndef INCLUDE_VIEW_BASE_RENDER_SCHEDULER_H_
+#define INCLUDE_VIEW_BASE_RENDER_SCHEDULER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace interface {
+
+/**
+ * @brief Merge every redraw request (originated from custom events) into at most one redraw per
+ * frame interval. As a single redraw handles every pending custom event, any request received while
+ * a redraw is already scheduled (or still not handled by screen) does not need another one.
+ */
+class RenderScheduler {
+ public:
+  //! Callback to trigger a screen redraw
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Statistics about redraw requests
+   */
+  struct Statistics {
+    int requested = 0;  //!< Redraws requested
+    int rendered = 0;   //!< Redraws triggered
+    int merged = 0;     //!< Requests merged into a redraw that was already scheduled
+    int dropped = 0;    //!< Requests dropped, as screen was still handling the previous redraw
+  };
+
+  /**
+   * @brief Construct a new RenderScheduler object (and spawn its thread)
+   * @param redraw Callback to trigger a screen redraw
+   * @param frame_rate Maximum redraws per second
+   */
+  explicit RenderScheduler(Callback redraw, int frame_rate = kDefaultFrameRate);
+
+  /**
+   * @brief Destroy the RenderScheduler object
+   */
+  ~RenderScheduler();
+
+  //! Remove these
+  RenderScheduler(const RenderScheduler& other) = delete;             // copy constructor
+  RenderScheduler(RenderScheduler&& other) = delete;                  // move constructor
+  RenderScheduler& operator=(const RenderScheduler& other) = delete;  // copy assignment
+  RenderScheduler& operator=(RenderScheduler&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Request a screen redraw (thread-safe), which happens as soon as frame interval allows it
+   */
+  void RequestRedraw();
+
+  /**
+   * @brief Notify that screen is handling the last redraw, so any request after this one must
+   * trigger a new redraw (must be called before handling pending custom events)
+   */
+  void NotifyRedrawHandled();
+
+  /**
+   * @brief Set maximum redraws per second
+   * @param value Frames per second (clamped to a sane range)
+   */
+  void SetFrameRate(int value);
+
+  /**
+   * @brief Stop scheduler thread, so no redraw is triggered anymore
+   */
+  void Stop();
+
+  /**
+   * @brief Get statistics since scheduler was created
+   * @return Redraw statistics
+   */
+  Statistics GetStatistics() const;
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  /**
+   * @brief Thread to trigger redraws, respecting frame interval between them
+   */
+  void SchedulerHandler();
+
+  /* ******************************************************************************************** */
+  //! Constants
+ public:
+  static constexpr int kDefaultFrameRate = 60;  //!< Default maximum redraws per second
+  static constexpr int kMinFrameRate = 10;      //!< Minimum value for maximum redraws per second
+  static constexpr int kMaxFrameRate = 240;     //!< Maximum value for maximum redraws per second
+
+  //! Interval to report redraw statistics
+  static constexpr std::chrono::seconds kReportInterval{10};
+
+  //! Maximum time to wait for screen to handle a redraw, before assuming it got lost
+  static constexpr std::chrono::seconds kRedrawTimeout{1};
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  Callback redraw_;  //!< Trigger a screen redraw
+
+  std::atomic<int> frame_rate_;  //!< Maximum redraws per second
+
+  mutable std::mutex mutex_;          //!< Control access for internal state
+  std::condition_variable notifier_;  //!< Wake up scheduler thread
+
+  bool pending_ = false;    //!< A redraw was requested and is waiting for its frame interval
+  bool in_flight_ = false;  //!< A redraw was triggered but screen did not handle it yet
+  bool exit_ = false;       //!< Scheduler thread must exit
+
+  std::chrono::steady_clock::time_point last_redraw_;  //!< Last time a redraw was triggered
+
+  Statistics stats_;  //!< Redraw statistics
+
+  std::thread loop_;  //!< Execute scheduler thread
+};
+
+}  // namespace interface
+#endif  // INCLUDE_VIEW_BASE_RENDER_SCHEDULER_H_
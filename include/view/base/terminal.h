@@ -17,6 +17,7 @@
 #include "view/base/block.h"
 #include "view/base/custom_event.h"
 #include "view/base/event_dispatcher.h"
+#include "view/base/render_scheduler.h"
 #include "view/element/error_dialog.h"
 #include "view/element/help_dialog.h"
 #include "view/element/playlist_dialog.h"
@@ -107,6 +108,12 @@ class Terminal : public EventDispatcher, public ftxui::ComponentBase {
    */
   void RegisterExitCallback(Callback cb);
 
+  /**
+   * @brief Set maximum frame rate for screen redraws triggered by custom events
+   * @param value Frames per second
+   */
+  void SetFrameRate(int value);
+
   /* ******************************************************************************************** */
   //! UI Interface API
 
@@ -204,6 +211,18 @@ class Terminal : public EventDispatcher, public ftxui::ComponentBase {
    */
   void UpdateFocus(int old_index, int new_index);
 
+  /**
+   * @brief Mark every block as dirty, so all of them are rendered again on next frame
+   */
+  void SetBlocksDirty();
+
+  /**
+   * @brief Render block (or reuse its last element, if block content did not change)
+   * @param index Block index
+   * @return Element Block element
+   */
+  ftxui::Element RenderBlock(int index);
+
   /**
    * @brief Check for all dialogs if any is opened
    * @return true if any dialog is visible, otherwise false
@@ -236,6 +255,10 @@ class Terminal : public EventDispatcher, public ftxui::ComponentBase {
   EventCallback cb_send_event_;  //!< Function to send custom events to terminal interface
   Callback cb_exit_;             //!< Function to exit from graphical interface
 
+  //! Merge redraws requested by custom events, limiting them to a maximum frame rate
+  std::unique_ptr<RenderScheduler> render_scheduler_;
+  int frame_rate_ = RenderScheduler::kDefaultFrameRate;  //!< Maximum redraws per second
+
   ftxui::Dimensions size_ = ftxui::Terminal::Size();  //!< Terminal maximum size
   int focused_index_ = 0;                             //!< Index of focused block
 
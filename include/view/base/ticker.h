@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \brief  Class to run periodic callbacks (like UI animations) from a single shared thread
+ */
+
+#ifndef INCLUDE_VIEW_BASE_TICKER_H_
+#define INCLUDE_VIEW_BASE_TICKER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace interface {
+
+/**
+ * @brief Shared timer service, where every periodic callback (like text animations) is registered
+ * with its own interval, instead of each one of them spawning a thread just to sleep most of the
+ * time. A single thread wakes up only at the earliest deadline among all callbacks registered.
+ */
+class Ticker {
+ public:
+  //! Callback triggered periodically (called from ticker thread)
+  using Callback = std::function<void()>;
+
+  //! Identifier for a registered callback (zero is never used)
+  using Id = uint64_t;
+
+ protected:
+  /**
+   * @brief Construct a new Ticker object
+   */
+  Ticker() = default;
+
+ public:
+  /**
+   * @brief Destroy the Ticker object (and wait for its thread to exit)
+   */
+  ~Ticker();
+
+  //! Remove these
+  Ticker(const Ticker& other) = delete;             // copy constructor
+  Ticker(Ticker&& other) = delete;                  // move constructor
+  Ticker& operator=(const Ticker& other) = delete;  // copy assignment
+  Ticker& operator=(Ticker&& other) = delete;       // move assignment
+
+  /* ******************************************************************************************** */
+  //! Public API
+
+  /**
+   * @brief Get unique instance of Ticker
+   * @return Ticker instance
+   */
+  static Ticker& GetInstance() {
+    // Simply extend the Ticker class, as we do not want to expose the default constructor,
+    // neither do we want to use std::make_unique explicitly calling operator new()
+    struct MakeUniqueEnabler : public Ticker {
+      using Ticker::Ticker;
+    };
+    static std::unique_ptr<Ticker> singleton = std::make_unique<MakeUniqueEnabler>();
+    return *singleton;
+  }
+
+  /**
+   * @brief Register a new callback to be triggered periodically (spawning ticker thread on first use)
+   * @param interval Time between each call
+   * @param callback Function to call
+   * @return Identifier to unregister callback later
+   */
+  Id Register(std::chrono::milliseconds interval, Callback callback);
+
+  /**
+   * @brief Unregister callback, so it is not triggered anymore. If it is running right now, wait
+   * for it to finish (unless called from the callback itself)
+   * @param id Identifier returned on registration
+   */
+  void Unregister(Id id);
+
+  /* ******************************************************************************************** */
+  //! Internal operations
+ private:
+  /**
+   * @brief Thread to trigger every callback whose deadline has passed
+   */
+  void TickerHandler();
+
+  //! Single callback registered
+  struct Timer {
+    std::chrono::milliseconds interval;              //!< Time between each call
+    std::chrono::steady_clock::time_point deadline;  //!< Time for next call
+    Callback callback;                               //!< Function to call
+  };
+
+  /* ******************************************************************************************** */
+  //! Variables
+ private:
+  std::mutex mutex_;                  //!< Control access for internal state
+  std::condition_variable notifier_;  //!< Wake up ticker thread (or anyone waiting for a callback)
+
+  std::map<Id, Timer> timers_;  //!< Every callback registered
+  Id next_id_ = 1;              //!< Identifier for next callback registered
+  Id running_ = 0;              //!< Identifier for callback running right now (zero for none)
+  bool exit_ = false;           //!< Ticker thread must exit
+
+  std::thread loop_;  //!< Execute ticker thread
+};
+
+}  // namespace interface
+#endif  // INCLUDE_VIEW_BASE_TICKER_H_
@@ -57,6 +57,13 @@ class FileInfo : public Block {
    */
   bool OnCustomEvent(const CustomEvent& event) override;
 
+  /**
+   * @brief Check if custom event may change block content
+   * @param event Received event
+   * @return true only for events with song information
+   */
+  bool IsAffectedBy(const CustomEvent& event) const override;
+
   /* ******************************************************************************************* */
   //! Utils
 
@@ -6,10 +6,13 @@
 #ifndef INCLUDE_VIEW_BLOCK_MAIN_CONTENT_SONG_LYRIC_H_
 #define INCLUDE_VIEW_BLOCK_MAIN_CONTENT_SONG_LYRIC_H_
 
-#include <chrono>
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
+#include <thread>
 
 #include "audio/lyric/base/html_parser.h"
 #include "audio/lyric/lyric_finder.h"
@@ -43,7 +46,7 @@ class SongLyric : public TabItem {
                      const FocusCallback& on_focus, const keybinding::Key& keybinding);
 
   /**
-   * @brief Destroy the SongLyric object
+   * @brief Destroy the SongLyric object (cancelling any fetch and waiting for its thread to exit)
    */
   ~SongLyric() override;
 
@@ -70,37 +73,37 @@ class SongLyric : public TabItem {
   /* ******************************************************************************************** */
   //! Private methods
  private:
+  //! Result from asynchronous fetch operation (if empty, it means that failed)
+  using FetchResult = std::optional<lyric::SongLyric>;
+
   /**
-   * @brief Check inner state from std::future
-   * @tparam R Result from asynchronous operation
-   * @param f Mechanism to execute asynchronous operation
-   * @param st Inner state
-   * @return true if state matches, otherwise false
+   * @brief Check state from fetch operation that is executed asynchronously
+   * @return true if fetch operation is still pending or executing, otherwise false
    */
-  template <typename R>
-  bool is_state(std::future<R>& f, std::future_status st) const {
-    return f.valid() && f.wait_for(std::chrono::seconds(0)) == st;
-  }
+  bool IsFetching();
 
   /**
-   * @brief Check state from fetch operation that is executed asynchronously
-   * @return true if fetch operation is still executing, otherwise false
+   * @brief Take result from last fetch operation (if finished since last call)
+   * @return Result from fetch operation, or empty if there is none
    */
-  bool IsFetching() { return async_fetcher_ && is_state(*async_fetcher_, std::future_status::timeout); }
+  std::optional<FetchResult> TakeResult();
 
   /**
-   * @brief Check state from fetch operation that is executed asynchronously
-   * @return true if fetch operation finished, otherwise false
+   * @brief Request fetcher thread to fetch song lyrics, cancelling any fetch still executing
+   * @param song Song information (if empty, only cancel)
    */
-  bool IsResultReady() { return async_fetcher_ && is_state(*async_fetcher_, std::future_status::ready); }
+  void RequestFetch(const std::optional<model::Song>& song);
 
-  //! Result from asynchronous fetch operation (if empty, it means that failed)
-  using FetchResult = std::optional<lyric::SongLyric>;
+  /**
+   * @brief Thread to fetch song lyrics for every song requested (one at a time)
+   */
+  void FetcherHandler();
 
   /**
-   * @brief Use updated song information to fetch song lyrics
+   * @brief Use song information to fetch song lyrics
+   * @param song Song information
    */
-  FetchResult FetchSongLyrics();
+  FetchResult FetchSongLyrics(const model::Song& song);
 
   /**
    * @brief Renders the song lyrics element
@@ -116,7 +119,18 @@ class SongLyric : public TabItem {
   int focused_ = 0;          //!< Index for paragraph focused from song lyric
 
   std::unique_ptr<lyric::LyricFinder> finder_ = lyric::LyricFinder::Create();  //!< Lyric finder
-  std::unique_ptr<std::future<FetchResult>> async_fetcher_;  //!< Use lyric finder asynchronously
+
+  std::mutex mutex_;                  //!< Control access for fetch state below
+  std::condition_variable notifier_;  //!< Wake up fetcher thread
+
+  std::optional<model::Song> request_;  //!< Song waiting for fetcher thread
+  std::optional<FetchResult> result_;   //!< Result from last fetch, waiting to be rendered
+  bool fetching_ = false;               //!< Fetcher thread is executing a fetch
+  bool exit_ = false;                   //!< Fetcher thread must exit
+
+  std::atomic<bool> cancelled_ = false;  //!< Cancel fetch executing (song changed or cleared)
+
+  std::thread fetcher_;  //!< Execute fetcher thread (must be the last one initialized)
 
   /* ******************************************************************************************** */
   //! Friend class for testing purpose
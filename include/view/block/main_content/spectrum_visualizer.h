@@ -6,8 +6,11 @@
 #ifndef INCLUDE_VIEW_BLOCK_MAIN_CONTENT_AUDIO_VISUALIZER_H_
 #define INCLUDE_VIEW_BLOCK_MAIN_CONTENT_AUDIO_VISUALIZER_H_
 
+#include <chrono>
+#include <memory>
 #include <string_view>
 
+#include "model/audio_spectrum.h"
 #include "model/bar_animation.h"
 #include "view/element/tab.h"
 
@@ -23,6 +26,13 @@ class SpectrumVisualizer : public TabItem {
   static constexpr int kGaugeMaxWidth = 4;      //!< Minimum value for gauge width
   static constexpr int kGaugeSpacing = 1;       //!< Spacing between gauges
 
+  //! Shortest and longest time to interpolate bars between two frames from audio analysis
+  static constexpr std::chrono::milliseconds kMinFrameInterval{4};
+  static constexpr std::chrono::milliseconds kMaxFrameInterval{100};
+
+  //! Acceleration for falling bars (in bar heights per second squared)
+  static constexpr model::Sample kGravity = 12.5;
+
  public:
   /**
    * @brief Construct a new SpectrumVisualizer object
@@ -69,8 +79,13 @@ class SpectrumVisualizer : public TabItem {
   /* ******************************************************************************************** */
   // Private methods
  private:
-  //! Utility to create UI gauge
-  void CreateGauge(double value, ftxui::Direction direction, ftxui::Elements& elements) const;
+  /**
+   * @brief Move displayed bars towards the most recent frame from audio analysis, based on elapsed
+   * time since last render (rising bars are interpolated until next frame is expected to arrive,
+   * while falling bars are pulled down by gravity)
+   * @return true if bars did not reach their target values yet, otherwise false
+   */
+  bool AnimateBars();
 
   //! Animations
   void DrawAnimationHorizontalMirror(ftxui::Element& visualizer);
@@ -81,8 +96,18 @@ class SpectrumVisualizer : public TabItem {
   //! Variables
   model::BarAnimation curr_anim_ =
       model::BarAnimation::HorizontalMirror;  //!< Control which bar animation to draw
-  std::vector<double> spectrum_data_;  //!< Audio spectrum (each entry represents a frequency bar)
+  model::AudioSpectrum spectrum_data_;  //!< Audio spectrum (each entry represents a frequency bar)
+  std::shared_ptr<model::SharedSpectrum> shared_spectrum_;  //!< Frames published by audio analysis
   int gauge_width_ = kGaugeDefaultWidth;  //!< Current audio bar width
+
+  model::AudioSpectrum target_;      //!< Most recent frame, where displayed bars are heading to
+  model::AudioSpectrum previous_;    //!< Displayed bars at the time that target was received
+  model::AudioSpectrum fall_speed_;  //!< Current speed for each falling bar
+
+  std::chrono::steady_clock::time_point last_render_;  //!< Last time that bars were animated
+  std::chrono::steady_clock::time_point target_time_;  //!< Last time that target was received
+  std::chrono::steady_clock::duration frame_interval_ =
+      kMaxFrameInterval;  //!< Interval between the last two frames from audio analysis
 };
 
 }  // namespace interface
@@ -56,6 +56,14 @@ class MediaPlayer : public Block {
    */
   bool OnCustomEvent(const CustomEvent& event) override;
 
+  /**
+   * @brief Check if custom event may change block content
+   *
+   * @param event Received event
+   * @return true if block must be rendered again, otherwise false
+   */
+  bool IsAffectedBy(const CustomEvent& event) const override;
+
   /* ******************************************************************************************** */
  private:
   //! Handle mouse event
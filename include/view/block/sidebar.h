@@ -62,6 +62,13 @@ class Sidebar : public Block {
    */
   bool OnCustomEvent(const CustomEvent& event) override;
 
+  /**
+   * @brief Check if custom event may change block content
+   * @param event Received event
+   * @return true if block must be rendered again, otherwise false
+   */
+  bool IsAffectedBy(const CustomEvent& event) const override;
+
   /**
    * @brief Receives an indication that block is now focused
    */
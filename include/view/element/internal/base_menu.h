@@ -6,6 +6,7 @@
 #ifndef INCLUDE_VIEW_ELEMENT_INTERNAL_BASE_MENU_H_
 #define INCLUDE_VIEW_ELEMENT_INTERNAL_BASE_MENU_H_
 
+#include <algorithm>
 #include <iomanip>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "view/base/element.h"
 #include "view/base/event_dispatcher.h"
 #include "view/base/keybinding.h"
+#include "view/element/internal/virtual_list.h"
 #include "view/element/text_animation.h"
 #include "view/element/util.h"
 
@@ -212,16 +214,14 @@ class BaseMenu : public Element {
 
     bool entry_focused = false;
 
-    for (int i = 0; i < GetSize(); ++i) {
-      if (!boxes_[i].Contain(event.mouse().x, event.mouse().y)) continue;
-
+    // Only entries visible during last render may be under mouse cursor
+    if (int i = viewport_.GetIndex(event.mouse().x, event.mouse().y); i >= 0 && i < GetSize()) {
       LOG_T("Handle double left click mouse event on entry=", i);
       entry_focused = true;
       *focused = i;
       *selected = i;
 
       if (click) OnClick();
-      break;
     }
 
     // If no entry was focused with mouse, reset index
@@ -404,9 +404,6 @@ class BaseMenu : public Element {
   //! Getter for event dispatcher
   std::shared_ptr<EventDispatcher> GetDispatcher() const { return dispatcher_.lock(); }
 
-  //! Getter for entries box
-  std::vector<ftxui::Box>& GetBoxes() { return boxes_; }
-
   //! Getter for selected index
   int* GetSelected() {
     return search_params_.has_value() ? &search_params_->selected_index : &selected_index_;
@@ -434,7 +431,7 @@ class BaseMenu : public Element {
   bool IsAnimationRunning() const { return animation_.enabled; }
 
   //! Getter for text from animation effect
-  std::string GetTextFromAnimation() const { return animation_.text; }
+  std::string GetTextFromAnimation() const { return animation_.GetText(); }
 
   /* ******************************************************************************************** */
   //! Highlight entry
@@ -549,7 +546,6 @@ class BaseMenu : public Element {
   //! Clamp both selected and focused indexes
   void Clamp() {
     int size = GetSize();
-    boxes_.resize(size);
 
     int* selected = IsSearchEnabled() ? &search_params_->selected_index : &selected_index_;
     int* focused = IsSearchEnabled() ? &search_params_->focused_index : &focused_index_;
@@ -558,6 +554,23 @@ class BaseMenu : public Element {
     *focused = clamp(*focused, 0, size - 1);
   }
 
+  /**
+   * @brief Create element for menu entries, where only entries visible on screen are created by
+   * derived class (instead of creating an element for each one of them on every render)
+   * @return Element to render entries list
+   */
+  ftxui::Element RenderEntries() {
+    // Element may be drawn again from a block cache (without calling Render), and entries are only
+    // created when it is drawn, so these must be limited to the entries that still exist by then
+    auto render = [this](int first, int last) {
+      last = std::min(last, GetSize());
+      return first < last ? actual().RenderEntriesImpl(first, last) : ftxui::Elements{};
+    };
+
+    return VirtualList(GetSize(), *GetFocused(), GetMaxColumns(), render, viewport_) |
+           ftxui::reflect(Box());
+  }
+
   //! Update content from active entry (decides if text_animation should run or not)
   void UpdateActiveEntry() {
     // Stop animation thread
@@ -582,7 +595,7 @@ class BaseMenu : public Element {
   std::weak_ptr<EventDispatcher> dispatcher_;  //!< Dispatch events for other blocks
   int max_columns_ = 0;  //!< Maximum value of columns available to render text
 
-  std::vector<ftxui::Box> boxes_;  //!< Single box for each entry in files list
+  Viewport viewport_;  //!< Entries visible on screen during last render
 
   int selected_index_ = 0;  //!< Index in list for selected entry
   int focused_index_ = 0;   //!< Index in list for focused entry
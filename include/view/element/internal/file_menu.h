@@ -6,11 +6,16 @@
 #ifndef INCLUDE_VIEW_ELEMENT_INTERNAL_FILE_MENU_H_
 #define INCLUDE_VIEW_ELEMENT_INTERNAL_FILE_MENU_H_
 
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "ftxui/component/event.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "util/file_handler.h"
+#include "util/library_index.h"
+#include "util/search_index.h"
 #include "view/element/internal/base_menu.h"
 #include "view/element/text_animation.h"
 
@@ -61,6 +66,9 @@ class FileMenu : public BaseMenu<FileMenu> {
   //! Renders the element
   ftxui::Element RenderImpl();
 
+  //! Create elements for entries within range [first, last)
+  ftxui::Elements RenderEntriesImpl(int first, int last);
+
   //! Handles an event (from mouse/keyboard)
   bool OnEventImpl(const ftxui::Event& event);
 
@@ -79,6 +87,38 @@ class FileMenu : public BaseMenu<FileMenu> {
   /* ******************************************************************************************** */
   //! Derived specialization
 
+  /**
+   * @brief Start listing files from the given directory path (replacing current list)
+   * @param dir_path Full path to directory
+   * @param timeout Maximum time to wait for listing, before leaving it running in background
+   * @return true if directory was opened succesfully, false otherwise
+   */
+  bool StartListing(const std::filesystem::path& dir_path, std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Take entries listed in background since last call, merging them into list
+   */
+  void ConsumeListing();
+
+  /**
+   * @brief Take changes from directory since last call (after listing has finished), applying
+   * them incrementally into list
+   */
+  void ConsumeChanges();
+
+  /**
+   * @brief Merge entries into list, keeping it sorted
+   * @param sorted Entries to add (already sorted)
+   */
+  void MergeEntries(util::Files& sorted);
+
+  /**
+   * @brief After entries have changed, move selected and focused indexes to the active entry
+   * @param active Active entry before changes
+   * @param previous Selected index before changes
+   */
+  void RestoreActiveEntry(const std::optional<util::File>& active, int previous);
+
   /**
    * @brief Compose directory path to list files from (based on given path)
    * @param optional_path Path to list files
@@ -86,17 +126,41 @@ class FileMenu : public BaseMenu<FileMenu> {
    */
   std::filesystem::path ComposeDirectoryPath(const std::string& optional_path);
 
+  /**
+   * @brief Enable search mode through every file under library root directory (instead of only
+   * those from current directory), starting library index on first use
+   */
+  void EnableGlobalSearch();
+
+  /**
+   * @brief Get text to show for an entry (on global search, its path relative to library root)
+   * @param entry File entry
+   * @return Entry text
+   */
+  std::string GetEntryText(const util::FileEntry& entry) const;
+
  public:
   /**
-   * @brief Refresh list with all files from the given directory path
+   * @brief Refresh list with all files from the given directory path (if listing takes too long,
+   * it keeps running in background and its entries are added to list as they arrive)
    * @param dir_path Full path to directory
-   * @return true if directory was parsed succesfully, false otherwise
+   * @return true if directory was opened succesfully, false otherwise
    */
   bool RefreshList(const std::filesystem::path& dir_path);
 
+  /**
+   * @brief Apply every update made in background since last call (entries listed, changes from
+   * directory and library index updates). Must be called when force_refresh callback is triggered,
+   * so render itself never changes the list
+   */
+  void ApplyPendingChanges();
+
   //! Get current directory
   const std::filesystem::path& GetCurrentDir() const { return curr_dir_; }
 
+  //! Check if current directory is still being listed
+  bool IsLoading() const { return listing_ != nullptr; }
+
   /* ******************************************************************************************** */
   //! Setters and getters
  private:
@@ -107,23 +171,30 @@ class FileMenu : public BaseMenu<FileMenu> {
   void SetEntriesImpl(const util::Files& entries);
 
   //! Getter for entries
-  util::Files GetEntriesImpl() const { return IsSearchEnabled() ? *filtered_entries_ : entries_; }
+  util::Files GetEntriesImpl() const;
 
   //! Emplace a new entry
   void EmplaceImpl(const util::File& entry) {
     LOG("Emplace a new entry to list");
-    entries_.emplace_back(entry);
+    std::error_code error;
+    entries_.push_back(util::FileEntry{
+        .path = entry,
+        .sort_key = util::make_sort_key(entry),
+        .type = std::filesystem::status(entry, error).type(),
+    });
+    UpdateSearchIndex();
   }
 
   //! Erase an existing entry
   void EraseImpl(const util::File& entry) {
     LOG("Attempt to erase an entry with value=", entry);
     auto it = std::find_if(entries_.begin(), entries_.end(),
-                           [&entry](const util::File& f) { return f == entry; });
+                           [&entry](const util::FileEntry& f) { return f.path == entry; });
 
     if (it != entries_.end()) {
-      LOG("Found matching entry, erasing it, entry=", *it);
+      LOG("Found matching entry, erasing it, entry=", it->path);
       entries_.erase(it);
+      UpdateSearchIndex();
     }
   }
 
@@ -136,8 +207,21 @@ class FileMenu : public BaseMenu<FileMenu> {
   //! Getter for active entry (focused/selected)
   std::optional<util::File> GetActiveEntryImpl() const;
 
+  //! Getter for active entry (focused/selected) with its cached information
+  const util::FileEntry* GetActiveFileEntry() const;
+
   //! Reset search mode (if enabled) and highlight the given entry
-  void ResetSearchImpl() { filtered_entries_.reset(); }
+  void ResetSearchImpl() {
+    filtered_entries_.reset();
+    global_search_ = false;
+    global_entries_.clear();
+  }
+
+  //! Getter for entry at the given position in list (considering search mode)
+  const util::FileEntry& GetEntryAt(int index) const;
+
+  //! Rebuild search index after entries have changed (and filter them again, if on search mode)
+  void UpdateSearchIndex();
 
   /* ******************************************************************************************** */
   //! Variables
@@ -145,17 +229,38 @@ class FileMenu : public BaseMenu<FileMenu> {
   std::filesystem::path curr_dir_;  //!< Current directory
   util::Files entries_;             //!< List containing files from current directory
 
-  //!< List containing only files matching the text from search
-  std::optional<util::Files> filtered_entries_ = std::nullopt;
+  util::SearchIndex search_index_;  //!< Index with lowercase filenames to search for
+
+  //!< Indexes (from list above) for files matching the text from search
+  std::optional<std::vector<int>> filtered_entries_ = std::nullopt;
 
   std::optional<util::File> highlighted_ = std::nullopt;  //!< Entry highlighted by owner
 
+  std::filesystem::path library_root_;           //!< Root directory for global search
+  std::unique_ptr<util::LibraryIndex> library_;  //!< Index with every file under library root
+  bool global_search_ = false;                   //!< Search mode looks for files in whole library
+  util::Files global_entries_;                   //!< Files from library matching text from search
+  int library_version_ = 0;                      //!< Library index version used for global search
+
   Callback on_click_;  //!< Callback function to trigger when menu entry is clicked/pressed
 
   std::shared_ptr<util::FileHandler> file_handler_;  //!< Utility class to manage files (read/write)
 
+  TextAnimation::Callback force_refresh_;            //!< Force UI update when new entries arrive
+  std::unique_ptr<util::DirectoryListing> listing_;  //!< Directory listing still running
+  std::unique_ptr<util::DirectoryWatcher> watcher_;  //!< Watch changes in current directory
+
+  //! Entry to select again once directory is listed again (after losing track of its changes)
+  std::optional<util::File> relisted_active_ = std::nullopt;
+
   Style style_;  //!< Style for each element inside this component
 
+  /* ******************************************************************************************** */
+  //! Constants
+
+  //! Maximum time to wait for directory listing, before showing it as loading
+  static constexpr std::chrono::milliseconds kListingTimeout{50};
+
   /* ******************************************************************************************** */
   //! Friend class for testing purpose
 
@@ -8,10 +8,13 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ftxui/component/event.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "model/playlist.h"
+#include "util/search_index.h"
 #include "view/element/internal/base_menu.h"
 #include "view/element/text_animation.h"
 
@@ -48,6 +51,13 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
   //! Definition of menu content (list of menu entries)
   using InternalPlaylists = std::vector<InternalPlaylist>;
 
+  //! A playlist matching the text from search (only indexes, resolved from entries while rendering)
+  struct FilteredPlaylist {
+    int index;               //!< Playlist index in list of entries
+    bool collapsed;          //!< Collapse state
+    std::vector<int> songs;  //!< Index of each song (from playlist above) matching the text
+  };
+
   //! Possible states for playlist entry collapse
   enum class CollapseState { Toggle, ForceOpen, ForceClose };
 
@@ -75,6 +85,9 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
   //! Renders the element
   ftxui::Element RenderImpl();
 
+  //! Create elements for entries within range [first, last)
+  ftxui::Elements RenderEntriesImpl(int first, int last);
+
   //! Handles an event (from mouse/keyboard)
   bool OnEventImpl(const ftxui::Event& event);
 
@@ -97,9 +110,7 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
   void SetEntriesImpl(const model::Playlists& entries);
 
   //! Getter for entries
-  InternalPlaylists GetEntriesImpl() const {
-    return IsSearchEnabled() ? *filtered_entries_ : entries_;
-  }
+  InternalPlaylists GetEntriesImpl() const;
 
   //! Emplace a new entry
   void EmplaceImpl(const model::Playlist& entry) {
@@ -107,6 +118,7 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
     auto index = (int)entries_.size();
     auto tmp = model::Playlist{.index = index, .name = entry.name, .songs = entry.songs};
     entries_.emplace_back(InternalPlaylist{.collapsed = false, .playlist = tmp});
+    UpdateSearchIndex();
   }
 
   //! Erase an existing entry
@@ -118,6 +130,7 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
     if (it != entries_.end()) {
       LOG("Found matching entry, erasing it, entry=", it->playlist);
       entries_.erase(it);
+      UpdateSearchIndex();
     }
   }
 
@@ -133,6 +146,24 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
   //! Reset search mode (if enabled) and highlight the given entry
   void ResetSearchImpl() { filtered_entries_.reset(); }
 
+  //! Getter for quantity of playlists in list (considering search mode)
+  int GetPlaylistsSize() const;
+
+  //! Getter for playlist at the given position in list (considering search mode)
+  const InternalPlaylist& GetPlaylistAt(int position) const;
+
+  //! Getter for quantity of songs from playlist at the given position (considering search mode)
+  int GetSongsSize(int position) const;
+
+  //! Getter for quantity of songs shown below playlist at the given position (zero if hidden)
+  int GetVisibleSongsSize(int position) const;
+
+  //! Getter for song index (in its own playlist) shown below playlist at the given position
+  int GetSongIndexAt(int position, int song) const;
+
+  //! Rebuild search index after entries have changed (and filter them again, if on search mode)
+  void UpdateSearchIndex();
+
   //! Create UI element for a single entry (playlist and song have different styles)
   ftxui::Element CreateEntry(int index, const std::string& text, bool is_highlighted,
                              bool is_playlist, const std::string& suffix = "");
@@ -155,8 +186,14 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
  private:
   InternalPlaylists entries_;  //!< List containing all parsed playlists
 
-  //!< List containing only playlists (+ songs) matching the text from search
-  std::optional<InternalPlaylists> filtered_entries_ = std::nullopt;
+  //! Index with lowercase names to search for (each playlist name followed by its song filenames)
+  util::SearchIndex search_index_;
+
+  //! Playlist and song (from list above) for each entry in search index
+  std::vector<std::pair<int, int>> search_entries_;
+
+  //!< Indexes for playlists (+ songs) matching the text from search
+  std::optional<std::vector<FilteredPlaylist>> filtered_entries_ = std::nullopt;
 
   //!< Index of song entry highlighted by owner
   std::optional<model::Song> highlighted_ = std::nullopt;
@@ -178,6 +215,12 @@ class PlaylistMenu : public BaseMenu<PlaylistMenu> {
           },
   };
 
+  /* ******************************************************************************************** */
+  //! Constants
+
+  //! Song index used in search entries for the playlist name itself
+  static constexpr int kPlaylistName = -1;
+
   /* ******************************************************************************************** */
   //! Friend class for testing purpose
 
@@ -8,10 +8,12 @@
 
 #include <deque>
 #include <string>
+#include <vector>
 
 #include "ftxui/component/event.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "model/song.h"
+#include "util/search_index.h"
 #include "view/element/internal/base_menu.h"
 #include "view/element/text_animation.h"
 
@@ -56,6 +58,9 @@ class SongMenu : public BaseMenu<SongMenu> {
   //! Renders the element
   ftxui::Element RenderImpl();
 
+  //! Create elements for entries within range [first, last)
+  ftxui::Elements RenderEntriesImpl(int first, int last);
+
   //! Handles an event (from mouse/keyboard)
   bool OnEventImpl(const ftxui::Event& event);
 
@@ -78,14 +83,13 @@ class SongMenu : public BaseMenu<SongMenu> {
   void SetEntriesImpl(const std::deque<model::Song>& entries);
 
   //! Getter for entries
-  std::deque<model::Song> GetEntriesImpl() const {
-    return IsSearchEnabled() ? *filtered_entries_ : entries_;
-  }
+  std::deque<model::Song> GetEntriesImpl() const;
 
   //! Emplace a new entry
   void EmplaceImpl(const model::Song& entry) {
     LOG("Emplace a new entry to list");
     entries_.emplace_back(entry);
+    UpdateSearchIndex();
   }
 
   //! Erase an existing entry
@@ -98,6 +102,7 @@ class SongMenu : public BaseMenu<SongMenu> {
     if (it != entries_.end()) {
       LOG("Found matching entry, erasing it, entry=", *it);
       entries_.erase(it);
+      UpdateSearchIndex();
     }
   }
 
@@ -113,13 +118,21 @@ class SongMenu : public BaseMenu<SongMenu> {
   //! Reset search mode (if enabled) and highlight the given entry
   void ResetSearchImpl() { filtered_entries_.reset(); }
 
+  //! Getter for entry at the given position in list (considering search mode)
+  const model::Song& GetEntryAt(int index) const;
+
+  //! Rebuild search index after entries have changed (and filter them again, if on search mode)
+  void UpdateSearchIndex();
+
   /* ******************************************************************************************** */
   //! Variables
  private:
   std::deque<model::Song> entries_;  //!< List containing song entries
 
-  //!< List containing only entries matching the text from search
-  std::optional<std::deque<model::Song>> filtered_entries_ = std::nullopt;
+  util::SearchIndex search_index_;  //!< Index with lowercase filenames to search for
+
+  //!< Indexes (from list above) for entries matching the text from search
+  std::optional<std::vector<int>> filtered_entries_ = std::nullopt;
 
   Callback on_click_;  //!< Callback function to trigger when menu entry is clicked/pressed
 
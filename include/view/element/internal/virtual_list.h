@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief  Header for Virtual List element
+ */
+
+#ifndef INCLUDE_VIEW_ELEMENT_INTERNAL_VIRTUAL_LIST_H_
+#define INCLUDE_VIEW_ELEMENT_INTERNAL_VIRTUAL_LIST_H_
+
+#include <functional>
+
+#include "ftxui/dom/elements.hpp"
+#include "ftxui/screen/box.hpp"
+
+namespace interface::internal {
+
+/**
+ * @brief Area from virtual list that was visible on screen during its last render
+ */
+struct Viewport {
+  ftxui::Box box;  //!< Screen area where entries are visible
+  int first = 0;   //!< Index for entry drawn on the first line of box
+
+  /**
+   * @brief Get index for entry drawn at the given screen coordinates
+   * @param x Column on screen
+   * @param y Line on screen
+   * @return Entry index, or -1 if coordinates are not within the visible area
+   */
+  int GetIndex(int x, int y) const { return box.Contain(x, y) ? first + (y - box.y_min) : -1; }
+};
+
+//! Callback to create elements for entries within the range [first, last)
+using EntriesRenderer = std::function<ftxui::Elements(int first, int last)>;
+
+/**
+ * @brief Create an element for a list of single-line entries, where only the entries visible on
+ * screen are created (so render cost does not depend on list size). List is scrolled the same way
+ * as ftxui::frame does, keeping the focused entry centered whenever possible.
+ * @param size Total number of entries
+ * @param focused Index for focused entry
+ * @param width Minimum width for entries
+ * @param render Callback to create elements for entries
+ * @param viewport Visible area, updated on every render (must outlive element)
+ * @return Element to render list
+ */
+ftxui::Element VirtualList(int size, int focused, int width, EntriesRenderer render,
+                           Viewport& viewport);
+
+}  // namespace interface::internal
+#endif  // INCLUDE_VIEW_ELEMENT_INTERNAL_VIRTUAL_LIST_H_
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief  Header for Spectrum element
+ */
+
+#ifndef INCLUDE_VIEW_ELEMENT_SPECTRUM_H_
+#define INCLUDE_VIEW_ELEMENT_SPECTRUM_H_
+
+#include <vector>
+
+#include "ftxui/dom/elements.hpp"
+#include "model/audio_spectrum.h"
+
+namespace interface {
+
+/**
+ * @brief A row of audio bars to draw in spectrum element
+ */
+struct SpectrumBars {
+  model::AudioSpectrum values;  //!< Bar values (from 0 to 1), ordered from left to right
+  bool upside_down = false;     //!< Draw bars from top to bottom, instead of bottom to top
+};
+
+/**
+ * @brief Create a single element drawing every audio bar straight into screen buffer (instead of
+ * composing gauge elements for each bar column). Each row of bars is horizontally centered and
+ * fills an equal share of the available height.
+ * @param rows Rows of audio bars, stacked from top to bottom
+ * @param bar_width Width for a single bar
+ * @param spacing Spacing between bars
+ * @return Element to draw audio bars
+ */
+ftxui::Element Spectrum(std::vector<SpectrumBars> rows, int bar_width, int spacing);
+
+}  // namespace interface
+#endif  // INCLUDE_VIEW_ELEMENT_SPECTRUM_H_
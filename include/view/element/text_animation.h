@@ -7,11 +7,12 @@
 #define INCLUDE_VIEW_ELEMENT_TEXT_ANIMATION_H_
 
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <string>
-#include <thread>
+
+#include "view/base/ticker.h"
 
 namespace interface {
 
@@ -19,42 +20,38 @@ namespace interface {
  * @brief An structure to offset selected entry text when its content is too long
  */
 struct TextAnimation {
-  using Callback = std::function<void()>;  //!< Callback triggered by internal thread
+  using Callback = std::function<void()>;  //!< Callback triggered by ticker thread
 
-  std::mutex mutex = std::mutex();  //!< Control access for internal resources
-  std::condition_variable notifier =
-      std::condition_variable();       //!< Conditional variable to block thread
-  std::thread thread = std::thread();  //!< Thread to perform offset animation on text
+  mutable std::mutex mutex = std::mutex();  //!< Control access for internal resources
 
-  std::atomic<bool> enabled = false;  //!< Flag to control thread animation
+  std::atomic<bool> enabled = false;  //!< Flag to control animation
   std::string text = "";              //!< Entry text to perform animation
 
   Callback cb_update = nullptr;  //!< Force an UI refresh
 
+  Ticker::Id id = 0;  //!< Identifier for animation callback registered on ticker
+
+  static constexpr std::chrono::milliseconds kInterval{200};  //!< Interval between each offset
+
   //! Destructor
   ~TextAnimation();
 
   /**
-   * @brief Start animation thread
+   * @brief Start animation (registering it on shared ticker)
    * @param entry Text content from selected entry
    */
   void Start(const std::string& entry);
 
   /**
-   * @brief Stop animation thread
+   * @brief Stop animation (after this, text is not modified anymore)
    */
   void Stop();
 
- private:
-  /**
-   * @brief Disable thread execution
-   */
-  void Notify();
-
   /**
-   * @brief Notify thread and wait for its stop
+   * @brief Get current text from animation (thread-safe)
+   * @return Entry text with its current offset
    */
-  void Exit();
+  std::string GetText() const;
 };
 
 }  // namespace interface
@@ -0,0 +1,34 @@
+#include "audio/driver/builtin_fft.h"
+
+#include "audio/driver/internal/fft.h"
+
+namespace driver {
+
+class BuiltinFft::Plan final : public Transform {
+  //! Release built-in plan
+  struct Deleter {
+    void operator()(internal::fft::Plan* p) const { internal::fft::DestroyPlan(p); }
+  };
+
+ public:
+  explicit Plan(internal::fft::Plan* plan) : plan_{plan} {}
+
+  void Execute() override { internal::fft::Execute(plan_.get()); }
+
+ private:
+  std::unique_ptr<internal::fft::Plan, Deleter> plan_;  //!< Built-in plan
+};
+
+/* ********************************************************************************************** */
+
+std::unique_ptr<BuiltinFft::Transform> BuiltinFft::CreateTransform(int size, int howmany, Real* in,
+                                                                   Complex* out) {
+  internal::fft::Plan* plan = internal::fft::PlanManyDftR2C(1, &size, howmany, in, nullptr, 1, size,
+                                                            out, nullptr, 1, size / 2 + 1, 0);
+
+  if (plan == nullptr) return nullptr;
+
+  return std::make_unique<Plan>(plan);
+}
+
+}  // namespace driver
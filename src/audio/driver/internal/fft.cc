@@ -0,0 +1,113 @@
+#include "audio/driver/internal/fft.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace driver {
+
+namespace internal {
+
+namespace fft {
+
+namespace {
+
+//! Memory alignment used by allocations (enough for AVX instructions)
+constexpr size_t kAlignment = 32;
+
+/**
+ * @brief Allocate aligned memory (size must be a multiple of alignment for std::aligned_alloc)
+ * @param bytes Size in bytes
+ * @return Pointer to allocated memory
+ */
+void* AllocAligned(size_t bytes) {
+  size_t size = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  return std::aligned_alloc(kAlignment, size > 0 ? size : kAlignment);
+}
+
+/**
+ * @brief Run transform with a fixed size over every input from plan
+ * @param plan Plan
+ */
+template <int N>
+void ExecuteMany(Plan& plan) {
+  using Transform = RealFft<model::Sample, N>;
+
+  for (int i = 0; i < plan.howmany; i++) {
+    const model::Sample* in = plan.in + i * plan.idist;
+    auto* out = reinterpret_cast<model::Sample*>(plan.out + i * plan.odist);
+
+    Transform::Forward(in, out, plan.scratch.data());
+  }
+}
+
+}  // namespace
+
+/* ********************************************************************************************** */
+
+model::Sample* AllocReal(size_t n) {
+  return static_cast<model::Sample*>(AllocAligned(sizeof(model::Sample) * n));
+}
+
+/* ********************************************************************************************** */
+
+Complex* AllocComplex(size_t n) { return static_cast<Complex*>(AllocAligned(sizeof(Complex) * n)); }
+
+/* ********************************************************************************************** */
+
+void Free(void* p) { std::free(p); }
+
+/* ********************************************************************************************** */
+
+Plan* PlanManyDftR2C(int rank, const int* n, int howmany, model::Sample* in, const int* inembed,
+                     int istride, int idist, Complex* out, const int* onembed, int ostride,
+                     int odist, unsigned) {
+  // Only the subset used by audio analysis is supported
+  if (rank != 1 || inembed != nullptr || onembed != nullptr || istride != 1 || ostride != 1) {
+    return nullptr;
+  }
+
+  if (std::find(kSupportedSizes.begin(), kSupportedSizes.end(), *n) == kSupportedSizes.end()) {
+    return nullptr;
+  }
+
+  return new Plan{
+      .size = *n,
+      .howmany = howmany,
+      .in = in,
+      .idist = idist,
+      .out = out,
+      .odist = odist,
+      .scratch = std::vector<model::Sample>(*n, 0),
+  };
+}
+
+/* ********************************************************************************************** */
+
+void Execute(Plan* plan) {
+  switch (plan->size) {
+    case 1024:
+      ExecuteMany<1024>(*plan);
+      break;
+
+    case 4096:
+      ExecuteMany<4096>(*plan);
+      break;
+
+    case 8192:
+      ExecuteMany<8192>(*plan);
+      break;
+
+    default:
+      break;
+  }
+}
+
+/* ********************************************************************************************** */
+
+void DestroyPlan(Plan* plan) { delete plan; }
+
+}  // namespace fft
+
+}  // namespace internal
+
+}  // namespace driver
@@ -0,0 +1,134 @@
+#include "audio/driver/internal/magnitude.h"
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace driver {
+
+namespace internal {
+
+model::Sample SumMagnitudesScalar(const model::Sample* data, int count) {
+  model::Sample sum = 0;
+
+  for (int i = 0; i < count; i++) {
+    model::Sample real = data[i * 2];
+    model::Sample imag = data[i * 2 + 1];
+
+    sum += std::sqrt(real * real + imag * imag);
+  }
+
+  return sum;
+}
+
+/* ********************************************************************************************** */
+
+#ifdef SPECTRUM_FFTW_FLOAT
+
+model::Sample SumMagnitudes(const model::Sample* data, int count) {
+  int i = 0;
+  model::Sample sum = 0;
+
+#if defined(__AVX__)
+  // Each iteration calculates magnitude for 8 complex numbers
+  __m256 acc = _mm256_setzero_ps();
+
+  for (; i + 8 <= count; i += 8) {
+    __m256 a = _mm256_loadu_ps(data + i * 2);
+    __m256 b = _mm256_loadu_ps(data + i * 2 + 8);
+
+    // Order does not matter for the sum, as long as each real part is paired to its imaginary part
+    __m256 real = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 imag = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+    __m256 squared = _mm256_add_ps(_mm256_mul_ps(real, real), _mm256_mul_ps(imag, imag));
+    acc = _mm256_add_ps(acc, _mm256_sqrt_ps(squared));
+  }
+
+  alignas(32) float partial[8];
+  _mm256_store_ps(partial, acc);
+  for (const auto& value : partial) sum += value;
+
+#elif defined(__SSE2__)
+  // Each iteration calculates magnitude for 4 complex numbers
+  __m128 acc = _mm_setzero_ps();
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 a = _mm_loadu_ps(data + i * 2);
+    __m128 b = _mm_loadu_ps(data + i * 2 + 4);
+
+    __m128 real = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 imag = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+    __m128 squared = _mm_add_ps(_mm_mul_ps(real, real), _mm_mul_ps(imag, imag));
+    acc = _mm_add_ps(acc, _mm_sqrt_ps(squared));
+  }
+
+  alignas(16) float partial[4];
+  _mm_store_ps(partial, acc);
+  for (const auto& value : partial) sum += value;
+#endif
+
+  // Remaining values
+  return sum + SumMagnitudesScalar(data + i * 2, count - i);
+}
+
+#else
+
+model::Sample SumMagnitudes(const model::Sample* data, int count) {
+  int i = 0;
+  model::Sample sum = 0;
+
+#if defined(__AVX__)
+  // Each iteration calculates magnitude for 4 complex numbers
+  __m256d acc = _mm256_setzero_pd();
+
+  for (; i + 4 <= count; i += 4) {
+    __m256d a = _mm256_loadu_pd(data + i * 2);
+    __m256d b = _mm256_loadu_pd(data + i * 2 + 4);
+
+    // Order does not matter for the sum, as long as each real part is paired to its imaginary part
+    __m256d real = _mm256_unpacklo_pd(a, b);
+    __m256d imag = _mm256_unpackhi_pd(a, b);
+
+    __m256d squared = _mm256_add_pd(_mm256_mul_pd(real, real), _mm256_mul_pd(imag, imag));
+    acc = _mm256_add_pd(acc, _mm256_sqrt_pd(squared));
+  }
+
+  alignas(32) double partial[4];
+  _mm256_store_pd(partial, acc);
+  for (const auto& value : partial) sum += value;
+
+#elif defined(__SSE2__)
+  // Each iteration calculates magnitude for 2 complex numbers
+  __m128d acc = _mm_setzero_pd();
+
+  for (; i + 2 <= count; i += 2) {
+    __m128d a = _mm_loadu_pd(data + i * 2);
+    __m128d b = _mm_loadu_pd(data + i * 2 + 2);
+
+    __m128d real = _mm_unpacklo_pd(a, b);
+    __m128d imag = _mm_unpackhi_pd(a, b);
+
+    __m128d squared = _mm_add_pd(_mm_mul_pd(real, real), _mm_mul_pd(imag, imag));
+    acc = _mm_add_pd(acc, _mm_sqrt_pd(squared));
+  }
+
+  alignas(16) double partial[2];
+  _mm_store_pd(partial, acc);
+  for (const auto& value : partial) sum += value;
+#endif
+
+  // Remaining values
+  return sum + SumMagnitudesScalar(data + i * 2, count - i);
+}
+
+#endif
+
+}  // namespace internal
+
+}  // namespace driver
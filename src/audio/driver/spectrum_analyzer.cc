@@ -0,0 +1,574 @@
+#include "audio/driver/spectrum_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "audio/driver/internal/fft.h"
+#include "audio/driver/internal/magnitude.h"
+#include "util/logger.h"
+
+namespace driver {
+
+void SpectrumAnalyzer::RealDeleter::operator()(Real* p) const { internal::fft::Free(p); }
+
+void SpectrumAnalyzer::ComplexDeleter::operator()(Complex* p) const { internal::fft::Free(p); }
+
+/* ********************************************************************************************** */
+
+error::Code SpectrumAnalyzer::Init(int output_size) {
+  if (output_size == 0) {
+    return error::kUnknownError;
+  }
+
+  std::scoped_lock init_lock(init_mutex_);
+
+  // Transform sizes never change, so transforms are created only once and reused by every state
+  if (!plans_created_) {
+    plans_created_ = CreatePlans();
+
+    if (!plans_created_) {
+      ERROR("Cannot create transforms for audio analysis");
+      return error::kUnknownError;
+    }
+  }
+
+  // Build the new state aside, so any running Execute is not blocked in the meantime
+  auto state = CreateState(output_size);
+
+  // Old states are released outside the lock, to keep Execute as short as possible
+  std::unique_ptr<State> unused, retired;
+
+  {
+    std::scoped_lock lock(mutex_);
+
+    if (!state_) {
+      // Nothing running yet, so simply use it right away
+      // Besides the biggest window, keep enough history for the decimation filter, so it never
+      // reads past the oldest sample, even if a single Execute fills the whole window
+      input_size_ = mid_.buffer_size * kNumberChannels;
+      input_capacity_ = input_size_ + kDecimationTaps * kNumberChannels;
+      input_ = std::vector<Real>(input_capacity_ * 2, 0);
+
+      decimated_size_ = bass_.buffer_size * kNumberChannels;
+      decimated_ = std::vector<Real>(decimated_size_ * 2, 0);
+      state_ = std::move(state);
+    } else {
+      // Otherwise, it will be swapped in by the end of the next Execute
+      unused = std::move(pending_);
+      retired = std::move(retired_);
+      pending_ = std::move(state);
+    }
+  }
+
+  return error::kSuccess;
+}
+
+/* ********************************************************************************************** */
+
+int SpectrumAnalyzer::GetOutputSize() {
+  std::scoped_lock lock(mutex_);
+  return state_ ? state_->output_size : 0;
+}
+
+/* ********************************************************************************************** */
+
+error::Code SpectrumAnalyzer::Execute(model::Sample* in, int size, model::Sample* out) {
+  std::scoped_lock lock(mutex_);
+  if (!state_) return error::kUnknownError;
+
+  int silence = 1;
+
+  // Use raw data to fill input
+  FillInputBuffer(in, size, silence);
+
+  // Split channels only once per input buffer (treble uses the same input from mid)
+  SplitChannels(input_.data() + head_ + input_capacity_ - 1, mid_.buffer_size, raw_.get());
+  SplitChannels(decimated_.data() + decimated_head_ + decimated_size_ - 1, bass_.buffer_size,
+                raw_bass_.get());
+
+  // Fill the bass, mid and treble buffers
+  ApplyFft(bass_, raw_bass_.get(), bass_.buffer_size);
+  ApplyFft(mid_, raw_.get(), mid_.buffer_size);
+  ApplyFft(treble_, raw_.get(), mid_.buffer_size);
+
+  // Separate frequency bands
+  SeparateFreqBands(*state_, out);
+
+  // Smoothing results with sensitivity adjustment
+  AdjustResults(*state_, out, silence);
+
+  // Output was written using the current size, so only now it is safe to swap in a new state
+  if (pending_) {
+    retired_ = std::move(state_);
+    state_ = std::move(pending_);
+  }
+
+  return error::kSuccess;
+}
+
+/* ********************************************************************************************** */
+
+std::unique_ptr<SpectrumAnalyzer::State> SpectrumAnalyzer::CreateState(int output_size) {
+  auto state = std::make_unique<State>();
+
+  state->output_size = output_size;
+  state->bars_per_channel = output_size / 2;
+
+  // Create buffers for output smoothing
+  CreateBuffers(*state);
+
+  // Calculate cutoff frequencies and equalize result
+  CalculateFrequencies(*state);
+
+  // Summarize results from the step above per bar
+  CreateLookupTables(*state);
+
+  return state;
+}
+
+/* ********************************************************************************************** */
+
+bool SpectrumAnalyzer::CreatePlans() {
+  // Bass keeps the same resolution from a DFT with 8192 samples, but using decimated input
+  bass_.buffer_size = kBufferSize * 8 / kDecimationFactor;
+  bass_.decimation = kDecimationFactor;
+  mid_.buffer_size = kBufferSize * 4;
+  treble_.buffer_size = kBufferSize;
+
+  // Allocate buffers for raw input split per channel
+  raw_.reset(internal::fft::AllocReal(mid_.buffer_size * kNumberChannels));
+  memset(raw_.get(), 0, sizeof(Real) * mid_.buffer_size * kNumberChannels);
+
+  raw_bass_.reset(internal::fft::AllocReal(bass_.buffer_size * kNumberChannels));
+  memset(raw_bass_.get(), 0, sizeof(Real) * bass_.buffer_size * kNumberChannels);
+
+  // Low-pass filter used before downsampling
+  CreateDecimationFilter();
+
+  // Hann Window calculate multipliers
+  CreateHannWindow(bass_);
+  CreateHannWindow(mid_);
+  CreateHannWindow(treble_);
+
+  // Allocate structures and create transforms from FFT backend
+  return CreateFftStructure(bass_) && CreateFftStructure(mid_) && CreateFftStructure(treble_);
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::CreateDecimationFilter() {
+  decimation_filter_ = std::vector<Real>(kDecimationTaps, 0);
+
+  // Windowed-sinc (using Blackman window) with cut-off at half of the decimated Nyquist frequency
+  // (~1378Hz), so the transition band ends before any frequency that could alias into bass range
+  double cut_off = 0.25 / kDecimationFactor;
+  double center = (kDecimationTaps - 1) / 2.;
+  double sum = 0;
+
+  for (int k = 0; k < kDecimationTaps; k++) {
+    double x = k - center;
+    double sinc = std::sin(2 * M_PI * cut_off * x) / (M_PI * x);
+    double window = 0.42 - 0.5 * std::cos(2 * M_PI * k / (kDecimationTaps - 1)) +
+                    0.08 * std::cos(4 * M_PI * k / (kDecimationTaps - 1));
+
+    decimation_filter_[k] = sinc * window;
+    sum += decimation_filter_[k];
+  }
+
+  // Normalize it to unity gain
+  for (auto& coefficient : decimation_filter_) coefficient /= sum;
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::CreateHannWindow(FreqAnalysis& analysis) {
+  analysis.multiplier.reset(internal::fft::AllocReal(analysis.buffer_size));
+
+  for (int i = 0; i < analysis.buffer_size; i++) {
+    analysis.multiplier.get()[i] = 0.5 * (1 - std::cos(2 * M_PI * i / (analysis.buffer_size - 1)));
+  }
+}
+
+/* ********************************************************************************************** */
+
+bool SpectrumAnalyzer::CreateFftStructure(FreqAnalysis& analysis) {
+  int size = analysis.buffer_size;
+  int out_size = analysis.buffer_size / 2 + 1;
+
+  // Both channels are kept in a single allocation, one after another
+  analysis.in.reset(internal::fft::AllocReal(size * kNumberChannels));
+  analysis.out.reset(internal::fft::AllocComplex(out_size * kNumberChannels));
+
+  analysis.plan = CreateTransform(size, kNumberChannels, analysis.in.get(), analysis.out.get());
+
+  memset(analysis.in.get(), 0, sizeof(Real) * size * kNumberChannels);
+  memset(analysis.out.get(), 0, sizeof(Complex) * out_size * kNumberChannels);
+
+  return analysis.plan != nullptr;
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::CreateBuffers(State& state) {
+  state.fall = std::vector<int>(state.output_size, 0);
+  state.memory = std::vector<Real>(state.output_size, 0);
+  state.peak = std::vector<Real>(state.output_size, 0);
+  state.previous_output = std::vector<Real>(state.output_size, 0);
+
+  state.cut_off_freq = std::vector<float>(state.bars_per_channel + 1, 0);
+  state.equalizer = std::vector<double>(state.bars_per_channel + 1, 0);
+
+  state.lower_cut_off_per_bar = std::vector<int>(state.bars_per_channel + 1);
+  state.upper_cut_off_per_bar = std::vector<int>(state.bars_per_channel + 1);
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::CalculateFrequencies(State& state) {
+  // Bass resolution is the same as if it was not decimated
+  int bass_size = bass_.buffer_size * bass_.decimation;
+
+  // Use lower cut off frequencies, to give a better resolution while keeping the responsiveness
+  int bass_reference = 100;
+  int treble_reference = 500;
+
+  // Calculate frequency constant (used to distribute bars across the frequency band)
+  double frequency_constant =
+      log10((float)kLowCutOff / (float)kHighCutOff) / (1 / ((float)state.bars_per_channel + 1) - 1);
+
+  float relative_cut_off[treble_.buffer_size];
+
+  state.bass_cut_off = -1;
+  state.treble_cut_off = -1;
+  int first_bar = 1;
+  int first_treble_bar = 0;
+  int bar_buffer[state.bars_per_channel + 1];
+
+  for (int n = 0; n < state.bars_per_channel + 1; n++) {
+    double bar_distribution_coefficient = frequency_constant * (-1);
+    bar_distribution_coefficient +=
+        ((float)n + 1) / ((float)state.bars_per_channel + 1) * frequency_constant;
+    state.cut_off_freq[n] = kHighCutOff * pow(10, bar_distribution_coefficient);
+
+    if (n > 0) {
+      if (state.cut_off_freq[n - 1] >= state.cut_off_freq[n] &&
+          state.cut_off_freq[n - 1] > bass_reference)
+        state.cut_off_freq[n] =
+            state.cut_off_freq[n - 1] + (state.cut_off_freq[n - 1] - state.cut_off_freq[n - 2]);
+    }
+
+    // Nyquist frequency
+    relative_cut_off[n] = state.cut_off_freq[n] / ((float)kSampleRate / 2);
+
+    // Numbers that come out of the FFT are very high, so the equalizer is used to "normalize" them
+    // by dividing with also a very huge number
+    state.equalizer[n] = pow(state.cut_off_freq[n], 1);
+    state.equalizer[n] /= pow(2, 18);
+    state.equalizer[n] /= log2(bass_size);
+
+    if (state.cut_off_freq[n] < bass_reference) {
+      // BASS
+      bar_buffer[n] = 1;
+      state.lower_cut_off_per_bar[n] = relative_cut_off[n] * ((float)bass_size / 2);
+      state.bass_cut_off++;
+      state.treble_cut_off++;
+      if (state.bass_cut_off > 0) first_bar = 0;
+
+      if (state.lower_cut_off_per_bar[n] > bass_size / 2) {
+        state.lower_cut_off_per_bar[n] = bass_size / 2;
+      }
+    } else if (state.cut_off_freq[n] > bass_reference && state.cut_off_freq[n] < treble_reference) {
+      // MID
+      bar_buffer[n] = 2;
+      state.lower_cut_off_per_bar[n] = relative_cut_off[n] * ((float)mid_.buffer_size / 2);
+      state.treble_cut_off++;
+      if ((state.treble_cut_off - state.bass_cut_off) == 1) {
+        first_bar = 1;
+        if (n > 0) {
+          state.upper_cut_off_per_bar[n - 1] = relative_cut_off[n] * ((float)bass_size / 2);
+        }
+      } else {
+        first_bar = 0;
+      }
+
+      if (state.lower_cut_off_per_bar[n] > mid_.buffer_size / 2) {
+        state.lower_cut_off_per_bar[n] = mid_.buffer_size / 2;
+      }
+    } else {
+      // TREBLE
+      bar_buffer[n] = 3;
+      state.lower_cut_off_per_bar[n] = relative_cut_off[n] * ((float)treble_.buffer_size / 2);
+      first_treble_bar++;
+      if (first_treble_bar == 1) {
+        first_bar = 1;
+        if (n > 0) {
+          state.upper_cut_off_per_bar[n - 1] = relative_cut_off[n] * ((float)mid_.buffer_size / 2);
+        }
+      } else {
+        first_bar = 0;
+      }
+
+      if (state.lower_cut_off_per_bar[n] > treble_.buffer_size / 2) {
+        state.lower_cut_off_per_bar[n] = treble_.buffer_size / 2;
+      }
+    }
+
+    if (n > 0) {
+      if (!first_bar) {
+        state.upper_cut_off_per_bar[n - 1] = state.lower_cut_off_per_bar[n] - 1;
+
+        // Pushing the spectrum up if the exponential function gets "clumped" in the bass and
+        // calculating new cut off frequencies
+        if (state.lower_cut_off_per_bar[n] <= state.lower_cut_off_per_bar[n - 1]) {
+          // Check if there is room for more first
+          int room_for_more = 0;
+
+          if (bar_buffer[n] == 1) {
+            if (state.lower_cut_off_per_bar[n - 1] + 1 < bass_size / 2 + 1) room_for_more = 1;
+          } else if (bar_buffer[n] == 2) {
+            if (state.lower_cut_off_per_bar[n - 1] + 1 < mid_.buffer_size / 2 + 1)
+              room_for_more = 1;
+          } else if (bar_buffer[n] == 3) {
+            if (state.lower_cut_off_per_bar[n - 1] + 1 < treble_.buffer_size / 2 + 1)
+              room_for_more = 1;
+          }
+
+          if (room_for_more) {
+            // Push the spectrum up
+            state.lower_cut_off_per_bar[n] = state.lower_cut_off_per_bar[n - 1] + 1;
+            state.upper_cut_off_per_bar[n - 1] = state.lower_cut_off_per_bar[n] - 1;
+
+            // Calculate new cut off frequency
+            switch (bar_buffer[n]) {
+              case 1:
+                relative_cut_off[n] =
+                    (float)(state.lower_cut_off_per_bar[n]) / ((float)bass_size / 2);
+                break;
+              case 2:
+                relative_cut_off[n] =
+                    (float)(state.lower_cut_off_per_bar[n]) / ((float)mid_.buffer_size / 2);
+                break;
+              case 3:
+                relative_cut_off[n] =
+                    (float)(state.lower_cut_off_per_bar[n]) / ((float)treble_.buffer_size / 2);
+                break;
+            }
+
+            state.cut_off_freq[n] = relative_cut_off[n] * ((float)kSampleRate / 2);
+          }
+        }
+      } else {
+        if (state.upper_cut_off_per_bar[n - 1] <= state.lower_cut_off_per_bar[n - 1])
+          state.upper_cut_off_per_bar[n - 1] = state.lower_cut_off_per_bar[n - 1] + 1;
+      }
+    }
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::CreateLookupTables(State& state) {
+  state.analysis_per_bar = std::vector<const FreqAnalysis*>(state.bars_per_channel, &bass_);
+  state.scale_per_bar = std::vector<Real>(state.bars_per_channel, 0);
+
+  for (int n = 0; n < state.bars_per_channel; n++) {
+    if (n > state.treble_cut_off) {
+      state.analysis_per_bar[n] = &treble_;
+    } else if (n > state.bass_cut_off) {
+      state.analysis_per_bar[n] = &mid_;
+    }
+
+    // Make sure to not exceed DFT output (decimated bass has less results)
+    const FreqAnalysis& analysis = *state.analysis_per_bar[n];
+    int max_index = analysis.buffer_size / 2;
+
+    state.upper_cut_off_per_bar[n] = std::min(state.upper_cut_off_per_bar[n], max_index);
+    state.lower_cut_off_per_bar[n] = std::min(state.lower_cut_off_per_bar[n], max_index);
+
+    // Average results and multiply with equalizer at once (bars without any result are zeroed).
+    // Also, DFT magnitude is proportional to its size, so compensate it for the decimated input
+    int count = state.upper_cut_off_per_bar[n] - state.lower_cut_off_per_bar[n] + 1;
+    if (count > 0) state.scale_per_bar[n] = state.equalizer[n] / count * analysis.decimation;
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::FillInputBuffer(Real* in, int& size, int& silence) {
+  if (size > input_size_) size = input_size_;
+
+  if (size > 0) {
+    frame_rate_ -= frame_rate_ / 64;
+    frame_rate_ += (double)((float)(kSampleRate * kNumberChannels * frame_skip_) / size) / 64;
+    frame_skip_ = 1;
+
+    // Fill the circular buffer, writing every sample twice (at most two chunks per copy)
+    int first_chunk = std::min(size, input_capacity_ - head_);
+    int second_chunk = size - first_chunk;
+
+    std::copy(in, in + first_chunk, input_.begin() + head_);
+    std::copy(in, in + first_chunk, input_.begin() + head_ + input_capacity_);
+
+    std::copy(in + first_chunk, in + size, input_.begin());
+    std::copy(in + first_chunk, in + size, input_.begin() + input_capacity_);
+
+    head_ = second_chunk > 0 ? second_chunk : head_ + first_chunk;
+    if (head_ == input_capacity_) head_ = 0;
+
+    if (std::any_of(in, in + size, [](Real sample) { return sample != 0; })) {
+      silence = 0;
+    }
+
+    // Downsample new data for bass analysis
+    Decimate(size / kNumberChannels);
+  } else {
+    frame_skip_++;
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::Decimate(int frames) {
+  // Most recent sample is the last one from the contiguous window starting at head
+  const Real* newest = input_.data() + head_ + input_capacity_ - 1;
+
+  // Filter reads previous frames from each new frame, so these must still be in the window
+  frames = std::min(frames, input_capacity_ / kNumberChannels - (kDecimationTaps - 1));
+
+  // Iterate over new frames in chronological order (where frame 0 is the most recent one)
+  for (int f = frames - 1; f >= 0; f--) {
+    if (++decimation_counter_ < kDecimationFactor) continue;
+    decimation_counter_ = 0;
+
+    // Polyphase decimation: filter output is calculated only for the frames that are kept
+    const Real* frame = newest - f * kNumberChannels;
+    Real left = 0;
+    Real right = 0;
+
+    for (int k = 0; k < kDecimationTaps; k++) {
+      right += decimation_filter_[k] * frame[-k * kNumberChannels];
+      left += decimation_filter_[k] * frame[-k * kNumberChannels - 1];
+    }
+
+    // Store it twice, using the same layout from input buffer
+    decimated_[decimated_head_] = decimated_[decimated_head_ + decimated_size_] = left;
+    decimated_[decimated_head_ + 1] = decimated_[decimated_head_ + decimated_size_ + 1] = right;
+
+    decimated_head_ += kNumberChannels;
+    if (decimated_head_ == decimated_size_) decimated_head_ = 0;
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::SplitChannels(const Real* newest, int frames, Real* raw) {
+  Real* left = raw;
+  Real* right = raw + frames;
+
+  // Read it backwards, as analysis expects the most recent samples first. And it is a plain loop
+  // without branches over contiguous memory, so compiler is able to vectorize it
+  for (int i = 0; i < frames; i++) {
+    right[i] = newest[-i * 2];
+    left[i] = newest[-i * 2 - 1];
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::ApplyFft(FreqAnalysis& analysis, const Real* raw, int raw_size) {
+  const Real* window = analysis.multiplier.get();
+  const Real* raw_left = raw;
+  const Real* raw_right = raw + raw_size;
+
+  Real* in_left = analysis.in.get();
+  Real* in_right = analysis.in.get() + analysis.buffer_size;
+
+  // Hann Window (shorter ranges simply use the most recent samples)
+  for (int j = 0; j < analysis.buffer_size; j++) {
+    in_left[j] = window[j] * raw_left[j];
+    in_right[j] = window[j] * raw_right[j];
+  }
+
+  // Run DFT for both channels at once
+  analysis.plan->Execute();
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::SeparateFreqBands(State& state, Real* out) {
+  for (int n = 0; n < state.bars_per_channel; n++) {
+    const FreqAnalysis& analysis = *state.analysis_per_bar[n];
+
+    int lower = state.lower_cut_off_per_bar[n];
+    int count = state.upper_cut_off_per_bar[n] - lower + 1;
+    Real scale = state.scale_per_bar[n];
+
+    // Add FFT values within bands (complex numbers are simply an array of real numbers in pairs)
+    const auto* left = reinterpret_cast<const Real*>(analysis.out_left() + lower);
+    const auto* right = reinterpret_cast<const Real*>(analysis.out_right() + lower);
+
+    out[n] = internal::SumMagnitudes(left, count) * scale;
+    out[n + state.bars_per_channel] = internal::SumMagnitudes(right, count) * scale;
+  }
+}
+
+/* ********************************************************************************************** */
+
+void SpectrumAnalyzer::AdjustResults(State& state, Real* out, int silence) {
+  // Applying sensitivity adjustment
+  for (int n = 0; n < state.output_size; n++) {
+    out[n] *= sensitivity_;
+  }
+
+  // Smoothing based on frame rate
+  int overshoot = 0;
+  double gravity_mod = pow((60 / frame_rate_), 2.5) * 1.54 / kNoiseReduction;
+
+  if (gravity_mod < 1) gravity_mod = 1;
+
+  // Calculate once per frame, instead of dividing it for every bar
+  double gravity_factor = gravity_mod / 1000;
+
+  for (int n = 0; n < state.output_size; n++) {
+    // Falloff
+    if (out[n] < state.previous_output[n]) {
+      out[n] = state.peak[n] * (1 - (state.fall[n] * state.fall[n] * gravity_factor));
+
+      if (out[n] < 0) out[n] = 0;
+      state.fall[n]++;
+    } else {
+      state.peak[n] = out[n];
+      state.fall[n] = 0;
+    }
+    state.previous_output[n] = out[n];
+
+    // Integral
+    out[n] = state.memory[n] * kNoiseReduction + out[n];
+    state.memory[n] = out[n];
+
+    double diff = 1000 - out[n];
+    if (diff < 0) diff = 0;
+    double div = 1 / (diff + 1);
+    state.memory[n] = state.memory[n] * (1 - div / 20);
+
+    // Check if we overshoot target height
+    if (out[n] > 1000) {
+      overshoot = 1;
+    }
+    out[n] /= 1000;
+  }
+
+  // Calculating automatic sensitivity adjustment
+  if (overshoot) {
+    sensitivity_ = sensitivity_ * 0.98;
+    sens_init_ = 0;
+  } else {
+    if (!silence) {
+      sensitivity_ = sensitivity_ * 1.001;
+      if (sens_init_) sensitivity_ = sensitivity_ * 1.1;
+    }
+  }
+}
+
+}  // namespace driver
@@ -6,7 +6,8 @@
 
 namespace driver {
 
-error::Code CURLWrapper::Fetch(const std::string &URL, std::string &output) {
+error::Code CURLWrapper::Fetch(const std::string &URL, std::string &output,
+                               const std::atomic<bool> &cancelled) {
   // Initialize cURL
   SmartCURL curl(curl_easy_init(), &curl_easy_cleanup);
 
@@ -20,6 +21,11 @@ error::Code CURLWrapper::Fetch(const std::string &URL, std::string &output) {
   curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, CURLWrapper::WriteCallback);
   curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &output);
 
+  // Configure progress callback, to abort transfer (even while connecting) when cancelled
+  curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 0L);
+  curl_easy_setopt(curl.get(), CURLOPT_XFERINFOFUNCTION, CURLWrapper::ProgressCallback);
+  curl_easy_setopt(curl.get(), CURLOPT_XFERINFODATA, &cancelled);
+
   // Set maximum timeout and disable any signal/alarm handlers
   curl_easy_setopt(curl.get(), CURLOPT_CONNECTTIMEOUT, 10L);
   curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1);
@@ -40,7 +46,10 @@ error::Code CURLWrapper::Fetch(const std::string &URL, std::string &output) {
   curl_easy_setopt(curl.get(), CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_3);
 
   LOG("Fetching content from URL=", URL);
-  if (CURLcode result = curl_easy_perform(curl.get()); result != CURLE_OK) {
+  if (CURLcode result = curl_easy_perform(curl.get()); result == CURLE_ABORTED_BY_CALLBACK) {
+    LOG("Cancelled fetching content from URL=", URL);
+    return error::kUnknownError;
+  } else if (result != CURLE_OK) {
     ERROR("Failed to execute cURL, error=", std::string(err_buffer.begin(), err_buffer.end()));
     return error::kUnknownError;
   }
@@ -56,4 +65,10 @@ size_t CURLWrapper::WriteCallback(const char *buffer, size_t size, size_t nmemb,
   return result;
 }
 
+/* ********************************************************************************************** */
+
+int CURLWrapper::ProgressCallback(void *data, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+  return *static_cast<const std::atomic<bool> *>(data) ? 1 : 0;
+}
+
 }  // namespace driver
@@ -54,14 +54,20 @@ LyricFinder::LyricFinder(std::unique_ptr<driver::UrlFetcher>&& fetcher,
 
 /* ********************************************************************************************** */
 
-SongLyric LyricFinder::Search(const std::string& artist, const std::string& title) {
+SongLyric LyricFinder::Search(const std::string& artist, const std::string& title,
+                              const std::atomic<bool>& cancelled) {
   LOG("Started fetching song by artist=", artist, " title=", title);
   std::string buffer;
   SongLyric lyrics;
 
   for (const auto& engine : engines_) {
+    if (cancelled) {
+      LOG("Cancelled fetching song lyrics");
+      break;
+    }
+
     // Fetch content from search engine
-    if (auto result = fetcher_->Fetch(engine->FormatSearchUrl(artist, title), buffer);
+    if (auto result = fetcher_->Fetch(engine->FormatSearchUrl(artist, title), buffer, cancelled);
         result != error::kSuccess) {
       ERROR("Failed to fetch URL content, error code=", result);
       continue;
@@ -321,9 +321,9 @@ void Player::AudioHandler() {
 void Player::CheckForNextSongFromPlaylist() {
   if (!curr_playlist_) return;
 
-  if (!curr_playlist_->IsEmpty()) {
-    LOG("Popping next song from internal playlist cache");
-    model::Song next_song = curr_playlist_->PopFront();
+  if (next_song_ < curr_playlist_->songs.size()) {
+    LOG("Getting next song from internal playlist cache");
+    const model::Song& next_song = curr_playlist_->songs[next_song_++];
 
     // Add directly to command queue
     media_control_.Push(Command::Play(next_song.filepath));
@@ -356,12 +356,15 @@ void Player::Play(const std::filesystem::path& filepath) {
 
 /* ********************************************************************************************** */
 
-void Player::Play(const model::Playlist& playlist) {
-  LOG("Add command to queue: Play (with ", playlist, ")");
-  bool already_playing = curr_playlist_.has_value();
+void Player::Play(const model::SharedPlaylist& playlist) {
+  if (!playlist) return;
 
-  // Update internal song queue
+  LOG("Add command to queue: Play (with ", *playlist, ")");
+  bool already_playing = curr_playlist_ != nullptr;
+
+  // Update internal song queue (shared with UI, so songs are never copied)
   curr_playlist_ = playlist;
+  next_song_ = 0;
 
   if (!already_playing) {
     // Enqueue first song
@@ -387,7 +390,7 @@ void Player::Stop() {
   media_control_.Push(Command::Stop());
 
   // Clear playlist
-  if (curr_playlist_.has_value()) curr_playlist_.reset();
+  if (curr_playlist_) curr_playlist_.reset();
 }
 
 /* ********************************************************************************************** */
@@ -3,6 +3,7 @@
  * \brief Main function
  */
 #include <cstdlib>
+#include <iostream>
 #include <string>
 
 #include "audio/player.h"
@@ -18,6 +19,8 @@
 struct Settings {
   std::string initial_dir = "";  //!< Initial directory to list in "files" block
   bool verbose_logging = false;  //!< Enable verbose log messages
+  int frame_rate = 0;            //!< Target frame rate for audio visualizer (0 means default)
+  int render_rate = 0;           //!< Maximum frame rate for screen redraws (0 means default)
 };
 
 /**
@@ -47,6 +50,16 @@ bool parse(int argc, char** argv, Settings& options) {
             .choices = {"-d", "--directory"},
             .description = "Initialize listing files from the given directory path",
         },
+        Argument{
+            .name = "fps",
+            .choices = {"-f", "--fps"},
+            .description = "Set target frame rate for audio analysis (default: 30)",
+        },
+        Argument{
+            .name = "render-fps",
+            .choices = {"-r", "--render-fps"},
+            .description = "Set maximum frame rate for screen redraws (default: 60)",
+        },
         Argument{
             .name = "verbose",
             .choices = {"-v", "--verbose"},
@@ -75,6 +88,26 @@ bool parse(int argc, char** argv, Settings& options) {
       options.initial_dir = initial_path->get_string();
     }
 
+    // Check if contains target frame rate for audio analysis
+    if (auto& frame_rate = parsed_args["fps"]; frame_rate) {
+      try {
+        options.frame_rate = std::stoi(frame_rate->get_string());
+      } catch (std::exception&) {
+        std::cout << "spectrum: invalid value for option [--fps]\n";
+        return false;
+      }
+    }
+
+    // Check if contains maximum frame rate for screen redraws
+    if (auto& render_rate = parsed_args["render-fps"]; render_rate) {
+      try {
+        options.render_rate = std::stoi(render_rate->get_string());
+      } catch (std::exception&) {
+        std::cout << "spectrum: invalid value for option [--render-fps]\n";
+        return false;
+      }
+    }
+
   } catch (util::parsing_error&) {
     // Got some error while trying to parse, or even received help as argument
     // Just let ArgumentParser handle it and exit application
@@ -105,6 +138,9 @@ int main(int argc, char** argv) {
   // Create and initialize a new middleware for terminal and player
   auto middleware = middleware::MediaController::Create(terminal, player, number_bars);
 
+  if (options.frame_rate > 0) middleware->SetAnalysisRate(options.frame_rate);
+  if (options.render_rate > 0) terminal->SetFrameRate(options.render_rate);
+
   // Register callbacks to Terminal and Player
   terminal->RegisterPlayerNotifier(middleware);
   player->RegisterInterfaceNotifier(middleware);
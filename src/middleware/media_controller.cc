@@ -1,8 +1,11 @@
 #include "middleware/media_controller.h"
 
+#include <algorithm>
 #include <thread>
 
-#ifndef SPECTRUM_DEBUG
+#if defined(SPECTRUM_BUILTIN_FFT)
+#include "audio/driver/builtin_fft.h"
+#elif !defined(SPECTRUM_DEBUG)
 #include "audio/driver/fftw.h"
 #else
 #include "debug/dummy_analyzer.h"
@@ -23,7 +26,11 @@ std::shared_ptr<MediaController> MediaController::Create(
     bool asynchronous) {
   LOG("Create new instance of media controller");
 
-#ifndef SPECTRUM_DEBUG
+#if defined(SPECTRUM_BUILTIN_FFT)
+  // Instantiate built-in FFT (which has no external dependency) to run audio analysis
+  auto an = analyzer != nullptr ? std::unique_ptr<driver::Analyzer>(std::move(analyzer))
+                                : std::make_unique<driver::BuiltinFft>();
+#elif !defined(SPECTRUM_DEBUG)
   // Instantiate FFTW to run audio analysis
   auto an = analyzer != nullptr ? std::unique_ptr<driver::Analyzer>(std::move(analyzer))
                                 : std::make_unique<driver::FFTW>();
@@ -46,9 +53,7 @@ std::shared_ptr<MediaController> MediaController::Create(
 
   controller->Init(number_bars, asynchronous);
 
-  // As we have no audio analysis output at this point, simply create a dummy output to show in UI
-  auto event_bars =
-      interface::CustomEvent::DrawAudioSpectrum(std::vector<double>(number_bars, 0.001));
+  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(controller->spectrum_);
   terminal->ProcessEvent(event_bars);
 
   return controller;
@@ -77,6 +82,10 @@ MediaController::~MediaController() {
   if (analysis_loop_.joinable()) {
     analysis_loop_.join();
   }
+
+  if (resize_loop_.joinable()) {
+    resize_loop_.join();
+  }
 }
 
 /* ********************************************************************************************** */
@@ -87,9 +96,16 @@ void MediaController::Init(int number_bars, bool asynchronous) {
   // Initialize internal structures
   analyzer_->Init(number_bars);
 
+  // As we have no audio analysis output at this point, simply create a dummy output to show in UI.
+  // This must be published before spawning analysis thread, as it is the only writer afterwards
+  spectrum_->Publish(model::AudioSpectrum(number_bars, 0.001));
+
   if (asynchronous) {
     // Spawn thread for Audio Analysis
     analysis_loop_ = std::thread(&MediaController::AnalysisHandler, this);
+
+    // Spawn thread to rebuild analyzer structures without blocking Audio Analysis
+    resize_loop_ = std::thread(&MediaController::ResizeHandler, this);
   }
 }
 
@@ -98,6 +114,14 @@ void MediaController::Init(int number_bars, bool asynchronous) {
 void MediaController::Exit() {
   LOG("Add command to queue: Exit");
   sync_data_.Push(Command::Exit);
+  resize_data_.Exit();
+}
+
+/* ********************************************************************************************** */
+
+void MediaController::SetAnalysisRate(int value) {
+  LOG("Set target frame rate for audio analysis to ", value);
+  analysis_rate_ = std::clamp(value, kMinAnalysisRate, kMaxAnalysisRate);
 }
 
 /* ********************************************************************************************** */
@@ -105,10 +129,21 @@ void MediaController::Exit() {
 void MediaController::AnalysisHandler() {
   LOG("Start analysis handler thread");
 
-  std::vector<double> input, output, previous;
+  using std::chrono::steady_clock;
+
+  std::vector<model::Sample> input;
+  model::AudioSpectrum output;
 
-  while (sync_data_.WaitForCommand()) {
-    // Get buffer size directly from audio analyzer, to discover chunk size to receive and send
+  // Control frame timing, so analysis runs at a fixed rate regardless of the period size used by
+  // Audio Player (and consecutive frames overlap over the analyzer history)
+  auto next_frame = steady_clock::now();
+
+  // Statistics to report real analysis frame rate
+  auto last_report = steady_clock::now();
+  int frames = 0, skipped = 0;
+
+  while (sync_data_.WaitForCommandOrFrame(next_frame)) {
+    // Get buffer size directly from audio analyzer, to discover maximum chunk size to send
     int in_size = analyzer_->GetBufferSize();
 
     // Resize output vector if necessary
@@ -119,18 +154,44 @@ void MediaController::AnalysisHandler() {
     auto command = sync_data_.Pop();
 
     switch (command) {
-      case Command::Analyze: {
+      case Command::None: {
+        // Unblocked without any command, so it is time to analyze a new frame
+        // P.S.: do not log this because it happens too often
+        int rate = analysis_rate_;
+        auto period = std::chrono::duration_cast<steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+
+        // Audio data consumed per frame (always keeping channels aligned)
+        int hop = std::min(kSampleRate * kNumberChannels / rate, in_size) & ~1;
+
+        // In case of running late, there is no point in trying to catch up with missed deadlines
+        auto now = steady_clock::now();
+        next_frame = (now - next_frame > period ? now : next_frame) + period;
+
         // Get input data, run FFT and update local cache
-        // P.S.: do not log this because this command is received too often
-        input = sync_data_.GetBuffer(in_size);
+        int discarded = sync_data_.GetFrame(hop, hop * kMaxPendingFrames, input);
         analyzer_->Execute(input.data(), static_cast<int>(input.size()), output.data());
-        previous = output;
+
+        // Only reuses buffer capacity, so no allocation happens after the first frame
+        spectrum_->Publish(output);
+
+        frames++;
+        skipped += discarded / hop;
+
+        if (auto elapsed = now - last_report; elapsed >= kRateReportInterval) {
+          double seconds = std::chrono::duration<double>(elapsed).count();
+          LOG("Audio analysis running at ", frames / seconds, " fps (target=", rate,
+              ", skipped=", skipped, ")");
+
+          last_report = now;
+          frames = skipped = 0;
+        }
 
         auto dispatcher = GetDispatcher();
         if (!dispatcher) break;
 
-        // Send result to UI
-        auto event = interface::CustomEvent::DrawAudioSpectrum(output);
+        // Notify UI that a new frame is available
+        auto event = interface::CustomEvent::DrawAudioSpectrum(spectrum_);
         dispatcher->SendEvent(event);
 
       } break;
@@ -138,7 +199,7 @@ void MediaController::AnalysisHandler() {
       case Command::RunClearAnimationWithRegain:
       case Command::RunClearAnimationWithoutRegain: {
         LOG("Analysis handler received command to run clear animation on audio visualizer");
-        ProcessClearAnimation(previous);
+        ProcessClearAnimation(static_cast<int>(output.size()));
 
         // Enqueue to run regain animation when song is resumed
         if (command == Command::RunClearAnimationWithRegain)
@@ -160,6 +221,19 @@ void MediaController::AnalysisHandler() {
 
 /* ********************************************************************************************** */
 
+void MediaController::ResizeHandler() {
+  LOG("Start resize handler thread");
+
+  while (auto output_size = resize_data_.WaitForRequest()) {
+    // Analyzer builds its new internal state aside and only swaps it during the next analysis,
+    // so there is no need to hold the audio data lock in here
+    LOG("Resize handler received request to resize analysis output to ", *output_size);
+    analyzer_->Init(*output_size);
+  }
+}
+
+/* ********************************************************************************************** */
+
 void MediaController::NotifyFileSelection(const std::filesystem::path& filepath) {
   auto player = player_ctl_.lock();
   if (!player) return;
@@ -197,8 +271,13 @@ void MediaController::SetVolume(model::Volume value) {
 /* ********************************************************************************************** */
 
 void MediaController::ResizeAnalysisOutput(int value) {
-  std::scoped_lock lock(sync_data_.mutex);
-  analyzer_->Init(value);
+  // When running synchronously (no threads spawned), resize right away
+  if (!resize_loop_.joinable()) {
+    analyzer_->Init(value);
+    return;
+  }
+
+  resize_data_.Push(value);
 }
 
 /* ********************************************************************************************** */
@@ -230,7 +309,7 @@ void MediaController::ApplyAudioFilters(const model::EqualizerPreset& filters) {
 
 /* ********************************************************************************************** */
 
-void MediaController::NotifyPlaylistSelection(const model::Playlist& playlist) {
+void MediaController::NotifyPlaylistSelection(const model::SharedPlaylist& playlist) {
   auto player = player_ctl_.lock();
   // TODO: add error log for every time that was not possible to acquire a lock for player instance
   if (!player) return;
@@ -302,60 +381,29 @@ void MediaController::NotifyError(error::Code code) {
 
 /* ********************************************************************************************** */
 
-void MediaController::ProcessClearAnimation(std::vector<double>& data) {
+void MediaController::ProcessClearAnimation(int size) {
   auto dispatcher = GetDispatcher();
   if (!dispatcher) return;
 
-  using namespace std::chrono_literals;
-
-  for (int i = 0; i < 10; i++) {
-    // Each time this loop is executed, it will reduce spectrum bar values to 35% based on its
-    // previous values (this value was decided based on feeling :P)
-    std::transform(data.begin(), data.end(), data.begin(),
-                   std::bind(std::multiplies<double>(), std::placeholders::_1, 0.35));
-
-    // Send result to UI
-    auto event = interface::CustomEvent::DrawAudioSpectrum(data);
-    dispatcher->SendEvent(event);
+  // Spectrum visualizer takes care of animating bars down to their new values
+  spectrum_->GetBackBuffer().assign(size, 0.001);
+  spectrum_->Publish();
 
-    // Sleep a little bit before sending a new update to UI. And in case of receiving a new
-    // command in the meantime, just cancel animation
-    auto timeout = std::chrono::system_clock::now() + 0.04s;
-    if (bool exit_animation = sync_data_.WaitForCommandOrUntil(timeout); exit_animation) break;
-  }
-
-  data = std::vector(data.size(), 0.001);
-
-  auto event = interface::CustomEvent::DrawAudioSpectrum(data);
+  auto event = interface::CustomEvent::DrawAudioSpectrum(spectrum_);
   dispatcher->SendEvent(event);
 }
 
 /* ********************************************************************************************** */
 
-void MediaController::ProcessRegainAnimation(const std::vector<double>& data) {
+void MediaController::ProcessRegainAnimation(const model::AudioSpectrum& data) {
   auto dispatcher = GetDispatcher();
   if (!dispatcher) return;
 
-  using namespace std::chrono_literals;
-
-  std::vector<double> bars;
-
-  for (int i = 1; i <= 10; i++) {
-    // Each time this loop is executed, it will increase spectrum bar values in a step of 10%
-    // based on its previous values (this value was also decided based on feeling)
-    for (const auto& value : data) bars.push_back((value / 10) * i);
+  // Spectrum visualizer takes care of animating bars up to their old values
+  spectrum_->Publish(data);
 
-    // Send result to UI
-    auto event = interface::CustomEvent::DrawAudioSpectrum(bars);
-    dispatcher->SendEvent(event);
-
-    // Sleep a little bit before sending a new update to UI. And in case of receiving a new
-    // command in the meantime, just cancel animation
-    auto timeout = std::chrono::system_clock::now() + 0.01s;
-    if (bool exit_animation = sync_data_.WaitForCommandOrUntil(timeout); exit_animation) break;
-
-    bars.clear();
-  }
+  auto event = interface::CustomEvent::DrawAudioSpectrum(spectrum_);
+  dispatcher->SendEvent(event);
 }
 
 /* ********************************************************************************************** */
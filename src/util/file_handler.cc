@@ -1,13 +1,26 @@
 #include "util/file_handler.h"
 
+#include <poll.h>
 #include <pwd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <exception>
 #include <fstream>
+#include <iterator>
 #include <set>
+#include <thread>
+#include <unordered_set>
 
 #include "nlohmann/json.hpp"
 #include "util/logger.h"
@@ -16,33 +29,381 @@ namespace util {
 
 namespace internal {
 
-//! Transform single character into lowercase
-static void to_lower(char& c) { c = (char)std::tolower(c); }
+/**
+ * @brief Convert modification time from stat into the clock used by std::filesystem (C++17 has no
+ * conversion between them, so their offset is computed once from a file queried both ways)
+ * @param time Modification time from stat
+ * @return Time point in file clock
+ */
+static std::filesystem::file_time_type ToFileTime(const struct timespec& time) {
+  using std::chrono::nanoseconds;
+  using std::chrono::seconds;
+
+  auto since_epoch = [](const struct timespec& t) {
+    return std::chrono::duration_cast<nanoseconds>(seconds{t.tv_sec} + nanoseconds{t.tv_nsec});
+  };
+
+  static const auto offset = [&since_epoch] {
+    struct stat root {};
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time("/", error);
+
+    if (error || ::stat("/", &root) != 0) return nanoseconds::zero();
+    return std::chrono::duration_cast<nanoseconds>(modified.time_since_epoch()) -
+           since_epoch(root.st_mtim);
+  }();
+
+  return std::filesystem::file_time_type{
+      std::chrono::duration_cast<std::filesystem::file_time_type::duration>(since_epoch(time) +
+                                                                            offset)};
+}
 
 /**
- * @brief Custom file sort algorithm
- * @param a Filename a
- * @param b Filename b
- * @return true if 'a' is alphabetically lesser than b, false otherwise
+ * @brief Create file entry from directory listing, caching its type, size and last modification
+ * time. All of them come from a single stat (querying each one from directory entry would make a
+ * new stat for each of them, which is slow on network mounts)
+ * @param entry Directory entry
+ * @return File entry
  */
-static bool sort_files(const File& a, const File& b) {
-  std::string lhs{a.filename()};
-  std::string rhs{b.filename()};
+static FileEntry CreateEntry(const std::filesystem::directory_entry& entry) {
+  using std::filesystem::file_type;
 
-  // Don't care if it is hidden (tried to make it similar to "ls" output)
-  if (lhs.at(0) == '.') lhs.erase(0, 1);
-  if (rhs.at(0) == '.') rhs.erase(0, 1);
+  FileEntry file{.path = entry.path(), .sort_key = make_sort_key(entry.path())};
+
+  // A broken entry is still listed, it just won't have any cached information
+  struct stat info {};
+  if (::stat(file.path.c_str(), &info) != 0) {
+    file.type = errno == ENOENT ? file_type::not_found : file_type::unknown;
+    return file;
+  }
+
+  switch (info.st_mode & S_IFMT) {
+    case S_IFDIR:
+      file.type = file_type::directory;
+      break;
+    case S_IFREG:
+      file.type = file_type::regular;
+      file.size = static_cast<std::uintmax_t>(info.st_size);
+      break;
+    case S_IFIFO:
+      file.type = file_type::fifo;
+      break;
+    case S_IFSOCK:
+      file.type = file_type::socket;
+      break;
+    case S_IFBLK:
+      file.type = file_type::block;
+      break;
+    case S_IFCHR:
+      file.type = file_type::character;
+      break;
+    default:
+      file.type = file_type::unknown;
+      break;
+  }
 
-  std::for_each(lhs.begin(), lhs.end(), to_lower);
-  std::for_each(rhs.begin(), rhs.end(), to_lower);
+  file.modified = ToFileTime(info.st_mtim);
 
-  return lhs < rhs;
+  return file;
 }
 
+//! Events watched in directory (a file rewritten is also watched, to update its cached size)
+static constexpr uint32_t kWatchedEvents =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE;
+
 }  // namespace internal
 
 /* ********************************************************************************************** */
 
+std::string make_sort_key(const File& path) {
+  std::string name{path.filename()};
+  std::string key;
+  key.reserve(name.size() + 8);
+
+  auto is_digit = [&name](size_t index) {
+    return index < name.size() && std::isdigit(static_cast<unsigned char>(name[index]));
+  };
+
+  // Don't care if it is hidden (tried to make it similar to "ls" output)
+  size_t i = !name.empty() && name.front() == '.' ? 1 : 0;
+
+  while (i < name.size()) {
+    if (!is_digit(i)) {
+      key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(name[i]))));
+      i++;
+      continue;
+    }
+
+    // Skip leading zeros, so numbers are compared only by their significant digits
+    size_t begin = i;
+    while (name[begin] == '0' && is_digit(begin + 1)) begin++;
+
+    size_t end = begin;
+    while (is_digit(end)) end++;
+
+    // Encode number as '0' followed by its length and digits, so a longer number is always greater
+    // and numbers are still sorted at the same position as digits, relative to any other character
+    key.push_back('0');
+    key.push_back(static_cast<char>(std::min<size_t>(end - begin, UCHAR_MAX)));
+    key.append(name, begin, end - begin);
+
+    i = end;
+  }
+
+  return key;
+}
+
+/* ********************************************************************************************** */
+
+bool sort_files(const FileEntry& a, const FileEntry& b) {
+  int result = a.sort_key.compare(b.sort_key);
+
+  // Only for names with the same key (like "1.mp3" and "01.mp3"), to keep a stable order
+  return result != 0 ? result < 0 : a.path < b.path;
+}
+
+/* ********************************************************************************************** */
+
+DirectoryListing::DirectoryListing(std::filesystem::directory_iterator iterator,
+                                   const Callback& notify)
+    : state_{std::make_shared<State>()} {
+  state_->notify = notify;
+
+  // Thread only shares internal state, so it can be detached and finish on its own after cancel
+  std::thread(&DirectoryListing::ListingHandler, std::move(iterator), state_).detach();
+}
+
+/* ********************************************************************************************** */
+
+DirectoryListing::~DirectoryListing() {
+  // After this, listing thread will never notify caller again
+  std::scoped_lock lock(state_->mutex);
+  state_->cancelled = true;
+  state_->notify = nullptr;
+}
+
+/* ********************************************************************************************** */
+
+bool DirectoryListing::WaitFor(std::chrono::milliseconds timeout) {
+  std::unique_lock lock(state_->mutex);
+  state_->notifier.wait_for(lock, timeout, [this] { return state_->finished; });
+
+  if (!state_->finished) state_->notify_enabled = true;
+  return state_->finished;
+}
+
+/* ********************************************************************************************** */
+
+bool DirectoryListing::Consume(Files& entries) {
+  std::scoped_lock lock(state_->mutex);
+  entries = std::move(state_->pending);
+  state_->pending.clear();
+
+  return state_->finished;
+}
+
+/* ********************************************************************************************** */
+
+void DirectoryListing::ListingHandler(std::filesystem::directory_iterator iterator,
+                                      std::shared_ptr<State> state) {
+  using std::chrono::steady_clock;
+
+  std::filesystem::directory_iterator end;
+  std::error_code error;
+
+  Files batch;
+  auto deadline = steady_clock::now() + kBatchInterval;
+
+  while (iterator != end && !state->cancelled) {
+    batch.push_back(internal::CreateEntry(*iterator));
+
+    // Deliver a batch when it is big enough or if directory is taking too long to list
+    if (batch.size() >= kMaxBatchSize || steady_clock::now() >= deadline) {
+      Deliver(batch, false, *state);
+      deadline = steady_clock::now() + kBatchInterval;
+    }
+
+    iterator.increment(error);
+
+    if (error) {
+      ERROR("Cannot list next entry from directory, error=", error.message());
+      break;
+    }
+  }
+
+  if (!state->cancelled) Deliver(batch, true, *state);
+}
+
+/* ********************************************************************************************** */
+
+void DirectoryListing::Deliver(Files& batch, bool finished, State& state) {
+  // Sort batch without holding lock
+  std::sort(batch.begin(), batch.end(), sort_files);
+
+  std::scoped_lock lock(state.mutex);
+  if (state.cancelled) return;
+
+  // And merge it into entries not taken yet, so they are always sorted
+  auto& pending = state.pending;
+  auto middle = pending.insert(pending.end(), std::make_move_iterator(batch.begin()),
+                               std::make_move_iterator(batch.end()));
+  std::inplace_merge(pending.begin(), middle, pending.end(), sort_files);
+  batch.clear();
+
+  if (finished) {
+    state.finished = true;
+    state.notifier.notify_all();
+  }
+
+  if (state.notify_enabled && state.notify) state.notify();
+}
+
+/* ********************************************************************************************** */
+
+DirectoryWatcher::State::~State() {
+  if (inotify >= 0) close(inotify);
+  if (wakeup >= 0) close(wakeup);
+}
+
+/* ********************************************************************************************** */
+
+DirectoryWatcher::DirectoryWatcher(const std::filesystem::path& dir_path, int descriptor,
+                                   const Callback& notify)
+    : state_{std::make_shared<State>()} {
+  state_->inotify = descriptor;
+  state_->wakeup = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  state_->notify = notify;
+
+  ERROR_IF(state_->wakeup < 0, "Cannot create event to stop watcher, error=", std::strerror(errno));
+
+  // Thread only shares internal state, so it can be detached and finish on its own after cancel
+  std::thread(&DirectoryWatcher::WatchingHandler, dir_path, state_).detach();
+}
+
+/* ********************************************************************************************** */
+
+DirectoryWatcher::~DirectoryWatcher() {
+  // After this, watching thread will never notify caller again
+  std::scoped_lock lock(state_->mutex);
+  state_->cancelled = true;
+  state_->notify = nullptr;
+
+  if (state_->wakeup >= 0) {
+    uint64_t value = 1;
+    [[maybe_unused]] auto result = write(state_->wakeup, &value, sizeof(value));
+  }
+}
+
+/* ********************************************************************************************** */
+
+bool DirectoryWatcher::Consume(Files& added, std::vector<File>& removed) {
+  std::scoped_lock lock(state_->mutex);
+
+  added.clear();
+  removed.clear();
+
+  for (auto& [path, entry] : state_->pending) {
+    removed.push_back(path);
+    if (entry) added.push_back(std::move(*entry));
+  }
+
+  state_->pending.clear();
+
+  bool overflow = state_->overflow;
+  state_->overflow = false;
+
+  return overflow;
+}
+
+/* ********************************************************************************************** */
+
+void DirectoryWatcher::WatchingHandler(std::filesystem::path dir_path,
+                                       std::shared_ptr<State> state) {
+  using std::chrono::steady_clock;
+
+  std::array<pollfd, 2> descriptors{{
+      {.fd = state->inotify, .events = POLLIN, .revents = 0},
+      {.fd = state->wakeup, .events = POLLIN, .revents = 0},
+  }};
+
+  alignas(inotify_event) std::array<char, 16 * 1024> buffer;
+
+  std::unordered_set<std::string> changed;
+  bool overflow = false;
+
+  // Without any event pending, there is no deadline to notify caller
+  constexpr auto kNoDeadline = steady_clock::time_point::max();
+  auto deadline = kNoDeadline;
+
+  while (!state->cancelled) {
+    // So sleep until a new event arrives
+    int timeout = -1;
+
+    if (deadline != kNoDeadline) {
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - steady_clock::now());
+      timeout = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+    }
+
+    if (poll(descriptors.data(), descriptors.size(), timeout) < 0 && errno != EINTR) {
+      ERROR("Cannot wait for directory events, error=", std::strerror(errno));
+      break;
+    }
+
+    if (state->cancelled) break;
+
+    if (descriptors[0].revents & POLLIN) {
+      ssize_t length = read(state->inotify, buffer.data(), buffer.size());
+
+      for (ssize_t offset = 0; offset < length;) {
+        const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+        if (event->mask & IN_Q_OVERFLOW) {
+          overflow = true;
+        } else if (event->len > 0) {
+          // Only the latest state of each entry matters, no matter how many events it had
+          changed.emplace(event->name);
+        }
+      }
+
+      // First event starts the interval to collect the following ones
+      if (deadline == kNoDeadline && (overflow || !changed.empty())) {
+        deadline = steady_clock::now() + kCoalesceInterval;
+      }
+    }
+
+    if (steady_clock::now() < deadline) continue;
+
+    // Query every entry changed without holding lock
+    std::unordered_map<std::string, std::optional<FileEntry>> batch;
+
+    for (const auto& name : changed) {
+      File path = dir_path / name;
+      std::error_code error;
+      std::filesystem::directory_entry entry(path, error);
+
+      // Entry is left empty if it does not exist anymore
+      batch.emplace(path.string(), !error && entry.exists(error)
+                                       ? std::optional{internal::CreateEntry(entry)}
+                                       : std::nullopt);
+    }
+
+    changed.clear();
+    deadline = kNoDeadline;
+
+    std::scoped_lock lock(state->mutex);
+    if (state->cancelled) break;
+
+    for (auto& [path, entry] : batch) state->pending[path] = std::move(entry);
+    state->overflow |= overflow;
+    overflow = false;
+
+    if (state->notify) state->notify();
+  }
+}
+
+/* ********************************************************************************************** */
+
 std::string FileHandler::GetHome() const {
 #ifdef _WIN32
   // On Windows, the home directory is typically in the USERPROFILE environment variable
@@ -63,13 +424,25 @@ std::string FileHandler::GetPlaylistsPath() const {
 
 /* ********************************************************************************************** */
 
+std::string FileHandler::GetFftwWisdomPath() const {
+  return std::string{GetHome() + "/.cache/spectrum/fftw.wisdom"};
+}
+
+/* ********************************************************************************************** */
+
+std::string FileHandler::GetLibraryIndexPath() const {
+  return std::string{GetHome() + "/.cache/spectrum/library.idx"};
+}
+
+/* ********************************************************************************************** */
+
 bool FileHandler::ListFiles(const std::filesystem::path& dir_path, Files& parsed_files) {
   Files tmp;
 
   try {
     // Add all files from the given directory
     for (auto const& entry : std::filesystem::directory_iterator(dir_path)) {
-      tmp.emplace_back(entry);
+      tmp.push_back(internal::CreateEntry(entry));
     }
   } catch (std::exception& e) {
     ERROR("Cannot access directory, exception=", e.what());
@@ -77,10 +450,12 @@ bool FileHandler::ListFiles(const std::filesystem::path& dir_path, Files& parsed
   }
 
   // Sort list alphabetically (case insensitive)
-  std::sort(tmp.begin(), tmp.end(), internal::sort_files);
+  std::sort(tmp.begin(), tmp.end(), sort_files);
 
   // Add option to go back one level
-  tmp.emplace(tmp.begin(), "..");
+  tmp.emplace(tmp.begin(), FileEntry{.path = "..",
+                                     .sort_key = make_sort_key(".."),
+                                     .type = std::filesystem::file_type::directory});
 
   // Update structure with parsed files
   parsed_files.swap(tmp);
@@ -90,6 +465,40 @@ bool FileHandler::ListFiles(const std::filesystem::path& dir_path, Files& parsed
 
 /* ********************************************************************************************** */
 
+std::unique_ptr<DirectoryListing> FileHandler::ListFilesAsync(
+    const std::filesystem::path& dir_path, const DirectoryListing::Callback& notify) {
+  try {
+    // Open directory right away, so any access error is reported to caller
+    std::filesystem::directory_iterator iterator(dir_path);
+    return std::make_unique<DirectoryListing>(std::move(iterator), notify);
+  } catch (std::exception& e) {
+    ERROR("Cannot access directory, exception=", e.what());
+    return nullptr;
+  }
+}
+
+/* ********************************************************************************************** */
+
+std::unique_ptr<DirectoryWatcher> FileHandler::WatchDirectory(
+    const std::filesystem::path& dir_path, const DirectoryWatcher::Callback& notify) {
+  int descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+  if (descriptor < 0) {
+    ERROR("Cannot create inotify instance, error=", std::strerror(errno));
+    return nullptr;
+  }
+
+  if (inotify_add_watch(descriptor, dir_path.c_str(), internal::kWatchedEvents) < 0) {
+    ERROR("Cannot watch directory, error=", std::strerror(errno));
+    close(descriptor);
+    return nullptr;
+  }
+
+  return std::make_unique<DirectoryWatcher>(dir_path, descriptor, notify);
+}
+
+/* ********************************************************************************************** */
+
 bool FileHandler::ParsePlaylists(model::Playlists& playlists) {
   std::string file_path{GetPlaylistsPath()};
 
@@ -0,0 +1,680 @@
+#include "util/library_index.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include "util/logger.h"
+
+namespace util {
+
+namespace internal {
+
+//! Transform single character into lowercase (same as std::tolower for the default "C" locale)
+static char to_lower(char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+//! Check if text contains query (which must be already in lowercase), ignoring case from text
+static bool contains(std::string_view text, std::string_view query) {
+  if (query.size() > text.size()) return false;
+
+  for (size_t i = 0, last = text.size() - query.size(); i <= last; i++) {
+    size_t j = 0;
+    while (j < query.size() && to_lower(text[i + j]) == query[j]) j++;
+
+    if (j == query.size()) return true;
+  }
+
+  return false;
+}
+
+//! Get bitmask with all characters contained in text (in lowercase), mapped to bits the same way as
+//! in SearchIndex: letters and digits have their own bits, and everything else shares the remaining
+static uint64_t get_mask(std::string_view text) {
+  uint64_t mask = 0;
+
+  for (char c : text) {
+    auto value = static_cast<unsigned char>(to_lower(c));
+    int bit = value >= 'a' && value <= 'z'   ? value - 'a'
+              : value >= '0' && value <= '9' ? 26 + value - '0'
+                                             : 36 + value % 28;
+
+    mask |= uint64_t{1} << bit;
+  }
+
+  return mask;
+}
+
+/**
+ * @brief Call function for every trigram from text (in lowercase), except for those crossing a
+ * directory separator: as directory paths and file names are indexed separately, a trigram from
+ * a file path either contains a separator or is entirely inside one of them
+ * @param text Text to split into trigrams
+ * @param function Function to call for each trigram
+ */
+template <typename Function>
+static void for_each_trigram(std::string_view text, Function&& function) {
+  for (size_t i = 0; i + 2 < text.size(); i++) {
+    if (text[i] == '/' || text[i + 1] == '/' || text[i + 2] == '/') continue;
+
+    auto byte = [&text](size_t index) {
+      return static_cast<uint32_t>(static_cast<unsigned char>(to_lower(text[index])));
+    };
+
+    function(byte(i) << 16 | byte(i + 1) << 8 | byte(i + 2));
+  }
+}
+
+//! Sort names the same way as files listed in a directory
+static void sort_names(std::vector<std::string>& names) {
+  std::vector<std::pair<std::string, std::string>> keys;
+  keys.reserve(names.size());
+
+  for (auto& name : names) keys.emplace_back(make_sort_key(name), std::move(name));
+  std::sort(keys.begin(), keys.end());
+
+  names.clear();
+  for (auto& [_, name] : keys) names.push_back(std::move(name));
+}
+
+/**
+ * @brief List names from every visible subdirectory and regular file in a directory (symlinks are
+ * skipped, so a scan never gets stuck in a loop)
+ * @param path Full path to directory
+ * @param files[out] Name of each regular file (sorted)
+ * @param subdirs[out] Name of each subdirectory (sorted)
+ */
+static void list_names(const std::filesystem::path& path, std::vector<std::string>& files,
+                       std::vector<std::string>& subdirs) {
+  std::error_code error;
+  std::filesystem::directory_iterator iterator(path, error), end;
+
+  for (; !error && iterator != end; iterator.increment(error)) {
+    const auto& entry = *iterator;
+    std::string name = entry.path().filename().string();
+
+    std::error_code entry_error;
+    if (name.empty() || name.front() == '.' || entry.is_symlink(entry_error)) continue;
+
+    if (entry.is_directory(entry_error)) {
+      subdirs.push_back(std::move(name));
+    } else if (entry.is_regular_file(entry_error)) {
+      files.push_back(std::move(name));
+    }
+  }
+
+  ERROR_IF(error, "Cannot list directory for library index, path=", path,
+           " error=", error.message());
+
+  sort_names(files);
+  sort_names(subdirs);
+}
+
+/* ********************************************************************************************** */
+
+//! Write a single value into binary file
+template <typename T>
+static void write_value(std::ofstream& file, const T& value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+//! Write text (preceded by its size) into binary file
+static void write_string(std::ofstream& file, const std::string& text) {
+  write_value(file, static_cast<uint32_t>(text.size()));
+  file.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+//! Write a list of texts (preceded by its size) into binary file
+static void write_strings(std::ofstream& file, const std::vector<std::string>& texts) {
+  write_value(file, static_cast<uint32_t>(texts.size()));
+  for (const auto& text : texts) write_string(file, text);
+}
+
+//! Write every trigram (followed by its identifiers) into binary file
+static void write_postings(std::ofstream& file,
+                           const std::unordered_map<uint32_t, std::vector<uint32_t>>& postings) {
+  write_value(file, static_cast<uint32_t>(postings.size()));
+
+  for (const auto& [trigram, ids] : postings) {
+    write_value(file, trigram);
+    write_value(file, static_cast<uint32_t>(ids.size()));
+    file.write(reinterpret_cast<const char*>(ids.data()),
+               static_cast<std::streamsize>(ids.size() * sizeof(uint32_t)));
+  }
+}
+
+//! Read a single value from binary file
+template <typename T>
+static bool read_value(std::ifstream& file, T& value) {
+  return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+//! Read a size from binary file, checking that it does not exceed the remaining bytes in file
+static bool read_size(std::ifstream& file, uint32_t& size, size_t remaining, size_t item_size) {
+  return read_value(file, size) && size_t{size} * item_size <= remaining;
+}
+
+//! Read text (preceded by its size) from binary file
+static bool read_string(std::ifstream& file, std::string& text, size_t remaining) {
+  uint32_t size = 0;
+  if (!read_size(file, size, remaining, 1)) return false;
+
+  text.resize(size);
+  return static_cast<bool>(file.read(text.data(), size));
+}
+
+//! Read a list of texts (preceded by its size) from binary file
+static bool read_strings(std::ifstream& file, std::vector<std::string>& texts, size_t remaining) {
+  uint32_t size = 0;
+  if (!read_size(file, size, remaining, sizeof(uint32_t))) return false;
+
+  texts.resize(size);
+  return std::all_of(texts.begin(), texts.end(),
+                     [&](std::string& text) { return read_string(file, text, remaining); });
+}
+
+//! Read every trigram (followed by its identifiers) from binary file
+static bool read_postings(std::ifstream& file,
+                          std::unordered_map<uint32_t, std::vector<uint32_t>>& postings,
+                          size_t remaining) {
+  uint32_t size = 0;
+  if (!read_size(file, size, remaining, 2 * sizeof(uint32_t))) return false;
+
+  postings.reserve(size);
+
+  for (uint32_t i = 0; i < size; i++) {
+    uint32_t trigram = 0, count = 0;
+    if (!read_value(file, trigram) || !read_size(file, count, remaining, sizeof(uint32_t)))
+      return false;
+
+    auto& ids = postings[trigram];
+    ids.resize(count);
+
+    if (!file.read(reinterpret_cast<char*>(ids.data()),
+                   static_cast<std::streamsize>(count * sizeof(uint32_t))))
+      return false;
+  }
+
+  return true;
+}
+
+//! Check that identifiers from every trigram are sorted (as expected by search) and below limit
+static bool check_postings(const std::unordered_map<uint32_t, std::vector<uint32_t>>& postings,
+                           size_t limit) {
+  return std::all_of(postings.begin(), postings.end(), [limit](const auto& entry) {
+    const auto& ids = entry.second;
+    return (ids.empty() || ids.back() < limit) &&
+           std::adjacent_find(ids.begin(), ids.end(), std::greater_equal<>()) == ids.end();
+  });
+}
+
+}  // namespace internal
+
+/* ********************************************************************************************** */
+
+LibraryIndex::LibraryIndex(const std::filesystem::path& root,
+                           const std::filesystem::path& cache_path, const Callback& notify)
+    : root_{root}, cache_path_{cache_path}, state_{std::make_shared<State>()} {
+  state_->notify = notify;
+
+  // Thread only shares internal state, so it can be detached and finish on its own after cancel
+  std::thread(&LibraryIndex::IndexHandler, root, cache_path, state_).detach();
+}
+
+/* ********************************************************************************************** */
+
+LibraryIndex::~LibraryIndex() {
+  // After this, indexing thread will never notify caller again
+  std::scoped_lock lock(state_->mutex);
+  state_->cancelled = true;
+  state_->notify = nullptr;
+}
+
+/* ********************************************************************************************** */
+
+std::vector<File> LibraryIndex::Search(std::string_view text, size_t max_results) const {
+  std::shared_ptr<const Snapshot> snapshot;
+
+  {
+    std::scoped_lock lock(state_->mutex);
+    snapshot = state_->snapshot;
+  }
+
+  std::vector<File> results;
+  if (!snapshot || text.empty() || max_results == 0) return results;
+
+  std::string query;
+  query.reserve(text.size());
+  std::transform(text.begin(), text.end(), std::back_inserter(query), internal::to_lower);
+
+  const auto& directories = snapshot->directories;
+  const auto& first_file = snapshot->first_file;
+
+  // Any file matching query must contain every trigram from it, so only look at files containing
+  // the rarest one (counting every file inside a directory whose path contains the trigram)
+  const std::vector<uint32_t> none;
+  const std::vector<uint32_t>* candidate_dirs = nullptr;
+  const std::vector<uint32_t>* candidate_files = nullptr;
+  size_t lowest_cost = std::numeric_limits<size_t>::max();
+
+  internal::for_each_trigram(query, [&](uint32_t trigram) {
+    auto dirs = snapshot->directory_postings.find(trigram);
+    auto files = snapshot->file_postings.find(trigram);
+
+    const auto* dir_ids = dirs != snapshot->directory_postings.end() ? &dirs->second : &none;
+    const auto* file_ids = files != snapshot->file_postings.end() ? &files->second : &none;
+
+    size_t cost = file_ids->size();
+    for (uint32_t dir : *dir_ids) cost += first_file[dir + 1] - first_file[dir];
+
+    if (cost < lowest_cost) {
+      lowest_cost = cost;
+      candidate_dirs = dir_ids;
+      candidate_files = file_ids;
+    }
+  });
+
+  // Check file path against query (the result for its directory path is reused between files)
+  const bool has_separator = query.find('/') != std::string::npos;
+  uint32_t last_dir = std::numeric_limits<uint32_t>::max();
+  bool last_dir_matches = false;
+  std::string path;
+
+  // Return true when there are enough results
+  auto check = [&](uint32_t dir, uint32_t id) {
+    const auto& directory = *directories[dir];
+    const auto& name = directory.files[id - first_file[dir]];
+    bool matches = false;
+
+    if (has_separator) {
+      path.assign(directory.path);
+      if (!path.empty()) path.push_back('/');
+      path.append(name);
+
+      matches = internal::contains(path, query);
+    } else {
+      if (dir != last_dir) {
+        last_dir = dir;
+        last_dir_matches = internal::contains(directory.path, query);
+      }
+
+      matches = last_dir_matches || internal::contains(name, query);
+    }
+
+    if (matches) results.push_back(root_ / directory.path / name);
+    return results.size() >= max_results;
+  };
+
+  // Query is too short to contain any trigram, so look at every file (but only compare text from
+  // those containing every character from query, unless directory path is already matching it)
+  if (!candidate_dirs) {
+    const uint64_t mask = internal::get_mask(query);
+    const auto& file_masks = snapshot->file_masks;
+
+    for (uint32_t dir = 0; dir < directories.size(); dir++) {
+      bool use_mask = !has_separator && !internal::contains(directories[dir]->path, query);
+
+      for (uint32_t id = first_file[dir]; id < first_file[dir + 1]; id++) {
+        if (use_mask && (file_masks[id] & mask) != mask) continue;
+        if (check(dir, id)) return results;
+      }
+    }
+
+    return results;
+  }
+
+  // Otherwise, merge both lists of candidates, to keep results in the same order as listed
+  auto file = candidate_files->begin();
+
+  auto check_file = [&](uint32_t id) {
+    auto dir = std::upper_bound(first_file.begin(), first_file.end(), id) - first_file.begin() - 1;
+    return check(static_cast<uint32_t>(dir), id);
+  };
+
+  for (uint32_t dir : *candidate_dirs) {
+    uint32_t begin = first_file[dir], end = first_file[dir + 1];
+
+    for (; file != candidate_files->end() && *file < begin; ++file) {
+      if (check_file(*file)) return results;
+    }
+
+    // These are already checked below, as part of the directory
+    while (file != candidate_files->end() && *file < end) ++file;
+
+    for (uint32_t id = begin; id < end; id++) {
+      if (check(dir, id)) return results;
+    }
+  }
+
+  for (; file != candidate_files->end(); ++file) {
+    if (check_file(*file)) return results;
+  }
+
+  return results;
+}
+
+/* ********************************************************************************************** */
+
+void LibraryIndex::Update() {
+  if (state_->updating.exchange(true)) return;
+
+  std::thread(&LibraryIndex::IndexHandler, root_, cache_path_, state_).detach();
+}
+
+/* ********************************************************************************************** */
+
+void LibraryIndex::IndexHandler(std::filesystem::path root, std::filesystem::path cache_path,
+                                std::shared_ptr<State> state) {
+  std::shared_ptr<const Snapshot> previous;
+
+  {
+    std::scoped_lock lock(state->mutex);
+    previous = state->snapshot;
+  }
+
+  // Index saved from last execution is available right away, while root directory is scanned
+  if (!previous) {
+    previous = Load(cache_path, root);
+    if (previous) Publish(previous, *state);
+  }
+
+  bool changed = false;
+  std::shared_ptr<Snapshot> snapshot = Scan(root, previous.get(), state->cancelled, changed);
+
+  if (snapshot && changed) {
+    BuildPostings(*snapshot, previous.get());
+
+    if (!state->cancelled) {
+      Publish(snapshot, *state);
+      Save(*snapshot, cache_path, root);
+    }
+  }
+
+  LOG("Finished library index update, changed=", changed);
+
+  std::scoped_lock lock(state->mutex);
+  state->updating = false;
+
+  if (state->notify) state->notify();
+}
+
+/* ********************************************************************************************** */
+
+std::shared_ptr<LibraryIndex::Snapshot> LibraryIndex::Scan(const std::filesystem::path& root,
+                                                           const Snapshot* previous,
+                                                           const std::atomic<bool>& cancelled,
+                                                           bool& changed) {
+  // Directories from previous scan, to reuse those not modified since then
+  std::unordered_map<std::string_view, std::shared_ptr<const Directory>> known;
+
+  if (previous) {
+    known.reserve(previous->directories.size());
+    for (const auto& dir : previous->directories) known.emplace(dir->path, dir);
+  }
+
+  auto snapshot = std::make_shared<Snapshot>();
+  std::vector<std::string> pending{std::string{}};
+
+  changed = false;
+
+  while (!pending.empty()) {
+    if (cancelled) return nullptr;
+
+    std::string path = std::move(pending.back());
+    pending.pop_back();
+
+    std::filesystem::path full_path = root / path;
+    std::error_code error;
+
+    auto last_write = std::filesystem::last_write_time(full_path, error);
+    if (error) continue;
+
+    auto modified = static_cast<int64_t>(last_write.time_since_epoch().count());
+    std::shared_ptr<const Directory> dir;
+
+    // Entries from a directory only change along with its modification time, so share it as is
+    if (auto it = known.find(path); it != known.end() && it->second->modified == modified) {
+      dir = it->second;
+    } else {
+      auto listed = std::make_shared<Directory>();
+      listed->path = std::move(path);
+      listed->modified = modified;
+
+      internal::list_names(full_path, listed->files, listed->subdirs);
+      dir = std::move(listed);
+      changed = true;
+    }
+
+    // Push subdirectories in reverse order, so they are indexed in the same order as listed
+    for (auto it = dir->subdirs.rbegin(); it != dir->subdirs.rend(); ++it) {
+      pending.push_back(dir->path.empty() ? *it : dir->path + '/' + *it);
+    }
+
+    snapshot->directories.push_back(std::move(dir));
+  }
+
+  // Any directory removed also modifies its parent, except for root directory itself
+  if (!previous || previous->directories.size() != snapshot->directories.size()) changed = true;
+
+  return snapshot;
+}
+
+/* ********************************************************************************************** */
+
+void LibraryIndex::BuildPostings(Snapshot& snapshot, const Snapshot* previous) {
+  const auto& directories = snapshot.directories;
+
+  // Leading directories shared with previous index keep the same identifiers (for themselves and
+  // for their files), so trigrams are only computed again from the first modified one onwards
+  uint32_t reused = 0;
+
+  if (previous) {
+    auto [first, _] = std::mismatch(directories.begin(), directories.end(),
+                                    previous->directories.begin(), previous->directories.end());
+    reused = static_cast<uint32_t>(first - directories.begin());
+  }
+
+  snapshot.first_file.clear();
+  snapshot.first_file.reserve(directories.size() + 1);
+  snapshot.directory_postings.clear();
+  snapshot.file_postings.clear();
+  snapshot.file_masks.clear();
+
+  if (reused > 0) {
+    const uint32_t reused_files = previous->first_file[reused];
+
+    snapshot.first_file.assign(previous->first_file.begin(),
+                               previous->first_file.begin() + reused);
+    snapshot.file_masks.assign(previous->file_masks.begin(),
+                               previous->file_masks.begin() + reused_files);
+
+    // Keep only identifiers below the first modified directory (and its first file)
+    auto copy = [](const Postings& from, Postings& to, uint32_t limit) {
+      to.reserve(from.size());
+
+      for (const auto& [trigram, ids] : from) {
+        auto last = std::lower_bound(ids.begin(), ids.end(), limit);
+        if (last != ids.begin()) to.emplace(trigram, std::vector<uint32_t>(ids.begin(), last));
+      }
+    };
+
+    copy(previous->directory_postings, snapshot.directory_postings, reused);
+    copy(previous->file_postings, snapshot.file_postings, reused_files);
+  }
+
+  uint32_t id = reused > 0 ? previous->first_file[reused] : 0;
+
+  // As identifiers are added in ascending order, only the last one must be checked for duplicates
+  auto append = [](std::vector<uint32_t>& ids, uint32_t value) {
+    if (ids.empty() || ids.back() != value) ids.push_back(value);
+  };
+
+  for (uint32_t dir = reused; dir < directories.size(); dir++) {
+    snapshot.first_file.push_back(id);
+
+    internal::for_each_trigram(directories[dir]->path, [&](uint32_t trigram) {
+      append(snapshot.directory_postings[trigram], dir);
+    });
+
+    for (const auto& name : directories[dir]->files) {
+      internal::for_each_trigram(
+          name, [&](uint32_t trigram) { append(snapshot.file_postings[trigram], id); });
+
+      snapshot.file_masks.push_back(internal::get_mask(name));
+      id++;
+    }
+  }
+
+  snapshot.first_file.push_back(id);
+}
+
+/* ********************************************************************************************** */
+
+std::shared_ptr<LibraryIndex::Snapshot> LibraryIndex::Load(const std::filesystem::path& cache_path,
+                                                           const std::filesystem::path& root) {
+  std::error_code error;
+  auto remaining = static_cast<size_t>(std::filesystem::file_size(cache_path, error));
+  if (error) return nullptr;
+
+  std::ifstream file(cache_path, std::ios::binary);
+  if (!file) return nullptr;
+
+  auto snapshot = std::make_shared<Snapshot>();
+
+  try {
+    uint32_t magic = 0, version = 0, size = 0;
+    std::string saved_root;
+
+    if (!internal::read_value(file, magic) || !internal::read_value(file, version) ||
+        magic != kFileMagic || version != kFileVersion) {
+      ERROR("Invalid library index file, path=", cache_path);
+      return nullptr;
+    }
+
+    // Index from another root directory is useless, as every path is relative to root
+    if (!internal::read_string(file, saved_root, remaining) || saved_root != root.string()) {
+      LOG("Library index file belongs to another root directory, ignoring it");
+      return nullptr;
+    }
+
+    if (!internal::read_size(file, size, remaining, sizeof(Directory::modified))) return nullptr;
+    snapshot->directories.reserve(size);
+
+    for (uint32_t i = 0; i < size; i++) {
+      auto dir = std::make_shared<Directory>();
+
+      if (!internal::read_string(file, dir->path, remaining) ||
+          !internal::read_value(file, dir->modified) ||
+          !internal::read_strings(file, dir->files, remaining) ||
+          !internal::read_strings(file, dir->subdirs, remaining)) {
+        ERROR("Truncated library index file, path=", cache_path);
+        return nullptr;
+      }
+
+      snapshot->directories.push_back(std::move(dir));
+    }
+
+    if (!internal::read_postings(file, snapshot->directory_postings, remaining) ||
+        !internal::read_postings(file, snapshot->file_postings, remaining)) {
+      ERROR("Truncated library index file, path=", cache_path);
+      return nullptr;
+    }
+  } catch (std::exception& e) {
+    ERROR("Cannot load library index, exception=", e.what());
+    return nullptr;
+  }
+
+  // Only trigrams are saved, as identifiers and masks for files are quickly computed from names
+  uint32_t id = 0;
+  snapshot->first_file.reserve(snapshot->directories.size() + 1);
+
+  for (const auto& dir : snapshot->directories) {
+    snapshot->first_file.push_back(id);
+    id += static_cast<uint32_t>(dir->files.size());
+
+    for (const auto& name : dir->files) snapshot->file_masks.push_back(internal::get_mask(name));
+  }
+
+  snapshot->first_file.push_back(id);
+
+  // Search uses identifiers to access directories and files directly, so these must be valid too
+  if (!internal::check_postings(snapshot->directory_postings, snapshot->directories.size()) ||
+      !internal::check_postings(snapshot->file_postings, id)) {
+    ERROR("Invalid identifiers in library index file, path=", cache_path);
+    return nullptr;
+  }
+
+  LOG("Loaded library index with directories=", snapshot->directories.size(), " files=", id);
+  return snapshot;
+}
+
+/* ********************************************************************************************** */
+
+bool LibraryIndex::Save(const Snapshot& snapshot, const std::filesystem::path& cache_path,
+                        const std::filesystem::path& root) {
+  std::error_code error;
+  std::filesystem::create_directories(cache_path.parent_path(), error);
+
+  std::filesystem::path tmp_path = cache_path;
+  tmp_path += ".tmp";
+
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+
+    if (!file) {
+      ERROR("Cannot open file to save library index, path=", tmp_path);
+      return false;
+    }
+
+    internal::write_value(file, kFileMagic);
+    internal::write_value(file, kFileVersion);
+    internal::write_string(file, root.string());
+    internal::write_value(file, static_cast<uint32_t>(snapshot.directories.size()));
+
+    for (const auto& dir : snapshot.directories) {
+      internal::write_string(file, dir->path);
+      internal::write_value(file, dir->modified);
+      internal::write_strings(file, dir->files);
+      internal::write_strings(file, dir->subdirs);
+    }
+
+    internal::write_postings(file, snapshot.directory_postings);
+    internal::write_postings(file, snapshot.file_postings);
+
+    if (!file.flush()) {
+      ERROR("Cannot write library index, path=", tmp_path);
+      std::filesystem::remove(tmp_path, error);
+      return false;
+    }
+  }
+
+  // Replace previous index only after new one is completely written
+  std::filesystem::rename(tmp_path, cache_path, error);
+
+  if (error) {
+    ERROR("Cannot save library index, error=", error.message());
+    std::filesystem::remove(tmp_path, error);
+    return false;
+  }
+
+  LOG("Saved library index with directories=", snapshot.directories.size());
+  return true;
+}
+
+/* ********************************************************************************************** */
+
+void LibraryIndex::Publish(std::shared_ptr<const Snapshot> snapshot, State& state) {
+  std::scoped_lock lock(state.mutex);
+  if (state.cancelled) return;
+
+  state.snapshot = std::move(snapshot);
+  state.version++;
+
+  if (state.notify) state.notify();
+}
+
+}  // namespace util
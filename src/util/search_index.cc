@@ -0,0 +1,236 @@
+#include "util/search_index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <numeric>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace util {
+
+namespace internal {
+
+//! Transform single character into lowercase
+static char to_lower(char c) {
+  return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+//! Check if character is a letter or digit
+static bool is_word(char c) { return std::isalnum(static_cast<unsigned char>(c)); }
+
+//! Check if every character from 'a' appears in 'b' in the same order
+static bool is_subsequence(std::string_view a, std::string_view b) {
+  size_t i = 0;
+  for (size_t j = 0; i < a.size() && j < b.size(); j++) {
+    if (a[i] == b[j]) i++;
+  }
+  return i == a.size();
+}
+
+//! Append index from every mask containing all bits from 'mask' (in a single contiguous pass)
+static void collect_matches(const std::vector<uint64_t>& masks, uint64_t mask,
+                            std::vector<int>& output) {
+  const int size = static_cast<int>(masks.size());
+  const uint64_t* data = masks.data();
+  int i = 0;
+
+#if defined(__AVX2__)
+  // Each iteration checks 4 masks at once, resulting in a 4-bit match bitmap
+  const __m256i wanted = _mm256_set1_epi64x(static_cast<long long>(mask));
+
+  for (; i + 4 <= size; i += 4) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i equal = _mm256_cmpeq_epi64(_mm256_and_si256(value, wanted), wanted);
+    int bitmap = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+
+    for (; bitmap != 0; bitmap &= bitmap - 1) output.push_back(i + __builtin_ctz(bitmap));
+  }
+#elif defined(__SSE2__)
+  // Each iteration checks 2 masks at once, resulting in a 2-bit match bitmap (as there is no 64-bit
+  // comparison in SSE2, both 32-bit halves must be equal)
+  const __m128i wanted = _mm_set1_epi64x(static_cast<long long>(mask));
+
+  for (; i + 2 <= size; i += 2) {
+    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i equal = _mm_cmpeq_epi32(_mm_and_si128(value, wanted), wanted);
+    equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+    int bitmap = _mm_movemask_pd(_mm_castsi128_pd(equal));
+
+    for (; bitmap != 0; bitmap &= bitmap - 1) output.push_back(i + __builtin_ctz(bitmap));
+  }
+#endif
+
+  // Remaining masks (or every one of them, without SIMD support)
+  for (; i < size; i++) {
+    if ((data[i] & mask) == mask) output.push_back(i);
+  }
+}
+
+}  // namespace internal
+
+/* ********************************************************************************************** */
+
+void SearchIndex::Clear() {
+  buffer_.clear();
+  offsets_.assign(1, 0);
+  masks_.clear();
+  cached_ = false;
+}
+
+/* ********************************************************************************************** */
+
+void SearchIndex::Add(std::string_view name) {
+  auto begin = buffer_.size();
+  std::transform(name.begin(), name.end(), std::back_inserter(buffer_), internal::to_lower);
+
+  offsets_.push_back(buffer_.size());
+  masks_.push_back(GetMask(std::string_view{buffer_}.substr(begin)));
+  cached_ = false;
+}
+
+/* ********************************************************************************************** */
+
+const std::vector<int>& SearchIndex::Filter(std::string_view text, size_t max_results) {
+  std::string query;
+  query.reserve(text.size());
+  std::transform(text.begin(), text.end(), std::back_inserter(query), internal::to_lower);
+
+  // Any entry matching the new query also matches the previous one, so there is no need to search
+  // through every entry again (this is the case for almost every new character typed)
+  bool narrow = cached_ && internal::is_subsequence(query_, query);
+
+  query_ = query;
+  cached_ = true;
+
+  // Discard entries missing any character from query (a cheap check to skip scoring most of them)
+  const uint64_t mask = GetMask(query);
+
+  if (narrow) {
+    // Only a few candidates are left from previous query, so check just them
+    auto last = std::remove_if(candidates_.begin(), candidates_.end(),
+                               [this, mask](int index) { return (masks_[index] & mask) != mask; });
+    candidates_.erase(last, candidates_.end());
+  } else {
+    // Check every entry in a single contiguous pass over masks
+    candidates_.clear();
+    internal::collect_matches(masks_, mask, candidates_);
+  }
+
+  // Nothing to rank, so just keep every entry
+  if (query.empty()) {
+    results_ = candidates_;
+    return results_;
+  }
+
+  // And then, calculate score for remaining entries
+  const std::string_view buffer{buffer_};
+  scored_.clear();
+
+  auto last = std::remove_if(candidates_.begin(), candidates_.end(), [&](int index) {
+    auto name = buffer.substr(offsets_[index], offsets_[index + 1] - offsets_[index]);
+    int score = Score(name, query);
+
+    if (score == kNoMatch) return true;
+
+    scored_.emplace_back(score, index);
+    return false;
+  });
+
+  candidates_.erase(last, candidates_.end());
+
+  // Keep only the best entries, sorted by highest score and lowest index
+  auto compare = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+  };
+
+  auto middle = scored_.begin() + std::min(scored_.size(), max_results);
+  std::partial_sort(scored_.begin(), middle, scored_.end(), compare);
+
+  results_.clear();
+  std::transform(scored_.begin(), middle, std::back_inserter(results_),
+                 [](const std::pair<int, int>& entry) { return entry.second; });
+
+  return results_;
+}
+
+/* ********************************************************************************************** */
+
+int SearchIndex::Score(std::string_view name, std::string_view query) {
+  if (query.empty()) return 0;
+
+  // Find first occurrence of query in name, from left to right
+  size_t start = 0, end = 0, matched = 0;
+
+  for (size_t i = 0; i < name.size() && matched < query.size(); i++) {
+    if (name[i] != query[matched]) continue;
+    if (matched == 0) start = i;
+    if (++matched == query.size()) end = i + 1;
+  }
+
+  if (matched < query.size()) return kNoMatch;
+
+  // And then, from right to left, to get a shorter match (like "ab" in "a_a_b" is "a_b")
+  for (size_t i = end; i-- > start;) {
+    if (name[i] != query[matched - 1]) continue;
+    if (--matched == 0) {
+      start = i;
+      break;
+    }
+  }
+
+  int score = 0, first_bonus = 0;
+  bool in_gap = false, consecutive = false;
+
+  for (size_t i = start, q = 0; i < end; i++) {
+    if (q == query.size() || name[i] != query[q]) {
+      score += in_gap ? kScoreGapExtension : kScoreGapStart;
+      in_gap = true;
+      consecutive = false;
+      continue;
+    }
+
+    // Characters right after a separator (or at the start of name) begin a new word
+    int bonus = i == 0 || !internal::is_word(name[i - 1]) ? kBonusBoundary : 0;
+
+    // A sequence of consecutive characters keeps the bonus from its first character
+    if (consecutive) {
+      first_bonus = std::max(first_bonus, bonus);
+      bonus = std::max({bonus, first_bonus, kBonusConsecutive});
+    } else {
+      first_bonus = bonus;
+    }
+
+    score += kScoreMatch + (q == 0 ? bonus * kBonusFirstCharMultiplier : bonus);
+    in_gap = false;
+    consecutive = true;
+    q++;
+  }
+
+  return score;
+}
+
+/* ********************************************************************************************** */
+
+uint64_t SearchIndex::GetMask(std::string_view text) {
+  uint64_t mask = 0;
+
+  for (char c : text) {
+    auto value = static_cast<unsigned char>(c);
+
+    // Letters and digits have their own bits, and everything else shares the remaining ones
+    int bit = std::islower(value)   ? value - 'a'
+              : std::isdigit(value) ? 26 + value - '0'
+                                    : 36 + value % 28;
+
+    mask |= uint64_t{1} << bit;
+  }
+
+  return mask;
+}
+
+}  // namespace util
@@ -13,6 +13,7 @@ Block::Block(const std::shared_ptr<EventDispatcher>& dispatcher, const model::Bl
 
 void Block::SetFocused(bool focused) {
   focused_ = focused;
+  dirty_ = true;
 
   if (focused_)
     OnFocus();
@@ -22,6 +23,17 @@ void Block::SetFocused(bool focused) {
 
 /* ********************************************************************************************** */
 
+ftxui::Element Block::RenderCached() {
+  if (dirty_ || !cache_) {
+    cache_ = Render();
+    dirty_ = false;
+  }
+
+  return cache_;
+}
+
+/* ********************************************************************************************** */
+
 ftxui::Decorator Block::GetTitleDecorator() const {
   using ftxui::bgcolor;
   using ftxui::bold;
@@ -2,6 +2,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 namespace interface {
 
@@ -14,20 +15,21 @@ struct ContentVisitor {
   // All mapped types used in the CustomEvent content
   void operator()(const std::monostate&) const { out << "empty"; }
   void operator()(int i) const { out << i; }
-  void operator()(const model::Song& s) const { out << s; }
+  void operator()(const CustomEvent::Shared<model::Song>& s) const { out << *s; }
   void operator()(const model::Volume& v) const { out << v; }
   void operator()(const model::Song::CurrentInformation& i) const { out << i; }
   void operator()(const std::filesystem::path& p) const { out << std::quoted(p.c_str()); }
-  void operator()(const std::vector<double>&) const { out << "{vector data...}"; }
-  void operator()(const model::EqualizerPreset&) const {
+  void operator()(const model::AudioSpectrum&) const { out << "{vector data...}"; }
+  void operator()(const std::shared_ptr<model::SharedSpectrum>&) const { out << "{new frame}"; }
+  void operator()(const CustomEvent::Shared<model::EqualizerPreset>&) const {
     // TODO: maybe implement detailed info here
     out << "{audio filter data...}";
   }
   void operator()(const model::BarAnimation& a) const { out << a; }
   void operator()(const model::BlockIdentifier& i) const { out << i; }
-  void operator()(const model::Playlist& p) const { out << p; }
+  void operator()(const CustomEvent::Shared<model::Playlist>& p) const { out << *p; }
   void operator()(const model::PlaylistOperation& p) const { out << p; }
-  void operator()(const model::QuestionData& q) const { out << q; }
+  void operator()(const CustomEvent::Shared<model::QuestionData>& q) const { out << *q; }
 
   std::ostream& out;
 };
@@ -218,11 +220,11 @@ CustomEvent CustomEvent::UpdateVolume(const model::Volume& sound_volume) {
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::UpdateSongInfo(const model::Song& info) {
+CustomEvent CustomEvent::UpdateSongInfo(model::Song info) {
   return CustomEvent{
       .type = Type::FromAudioThreadToInterface,
       .id = Identifier::UpdateSongInfo,
-      .content = info,
+      .content = std::make_shared<const model::Song>(std::move(info)),
   };
 }
 
@@ -238,7 +240,7 @@ CustomEvent CustomEvent::UpdateSongState(const model::Song::CurrentInformation&
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::DrawAudioSpectrum(const std::vector<double>& data) {
+CustomEvent CustomEvent::DrawAudioSpectrum(const model::AudioSpectrum& data) {
   return CustomEvent{
       .type = Type::FromAudioThreadToInterface,
       .id = Identifier::DrawAudioSpectrum,
@@ -248,6 +250,16 @@ CustomEvent CustomEvent::DrawAudioSpectrum(const std::vector<double>& data) {
 
 /* ********************************************************************************************** */
 
+CustomEvent CustomEvent::DrawAudioSpectrum(const std::shared_ptr<model::SharedSpectrum>& frames) {
+  return CustomEvent{
+      .type = Type::FromAudioThreadToInterface,
+      .id = Identifier::DrawAudioSpectrum,
+      .content = frames,
+  };
+}
+
+/* ********************************************************************************************** */
+
 CustomEvent CustomEvent::NotifyFileSelection(const std::filesystem::path& file_path) {
   return CustomEvent{
       .type = Type::FromInterfaceToAudioThread,
@@ -316,21 +328,21 @@ CustomEvent CustomEvent::SeekBackwardPosition(int offset) {
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::ApplyAudioFilters(const model::EqualizerPreset& filters) {
+CustomEvent CustomEvent::ApplyAudioFilters(model::EqualizerPreset filters) {
   return CustomEvent{
       .type = Type::FromInterfaceToAudioThread,
       .id = Identifier::ApplyAudioFilters,
-      .content = filters,
+      .content = std::make_shared<const model::EqualizerPreset>(std::move(filters)),
   };
 }
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::NotifyPlaylistSelection(const model::Playlist& playlist) {
+CustomEvent CustomEvent::NotifyPlaylistSelection(model::Playlist playlist) {
   return CustomEvent{
       .type = Type::FromInterfaceToAudioThread,
       .id = Identifier::NotifyPlaylistSelection,
-      .content = playlist,
+      .content = std::make_shared<const model::Playlist>(std::move(playlist)),
   };
 }
 
@@ -475,21 +487,21 @@ CustomEvent CustomEvent::ShowPlaylistManager(const model::PlaylistOperation& ope
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::SavePlaylistsToFile(const model::Playlist& changed_playlist) {
+CustomEvent CustomEvent::SavePlaylistsToFile(model::Playlist changed_playlist) {
   return CustomEvent{
       .type = Type::FromInterfaceToInterface,
       .id = Identifier::SavePlaylistsToFile,
-      .content = changed_playlist,
+      .content = std::make_shared<const model::Playlist>(std::move(changed_playlist)),
   };
 }
 
 /* ********************************************************************************************** */
 
-CustomEvent CustomEvent::ShowQuestionDialog(const model::QuestionData& data) {
+CustomEvent CustomEvent::ShowQuestionDialog(model::QuestionData data) {
   return CustomEvent{
       .type = Type::FromInterfaceToInterface,
       .id = Identifier::ShowQuestionDialog,
-      .content = data,
+      .content = std::make_shared<const model::QuestionData>(std::move(data)),
   };
 }
 
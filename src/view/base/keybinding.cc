@@ -39,6 +39,7 @@ Key Navigation::Delete = Key::Special("\x1B[3~");  //! Delete key
 Key Navigation::Close = Key::Character('q');
 
 Key Navigation::EnableSearch = Key::Character('/');
+Key Navigation::EnableGlobalSearch = Key::Character('?');
 
 /* ------------------------------------------ Dialog -------------------------------------------- */
 
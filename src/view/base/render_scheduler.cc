@@ -0,0 +1,142 @@
+#include "view/base/render_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "util/logger.h"
+
+namespace interface {
+
+RenderScheduler::RenderScheduler(Callback redraw, int frame_rate)
+    : redraw_{std::move(redraw)},
+      frame_rate_{std::clamp(frame_rate, kMinFrameRate, kMaxFrameRate)},
+      loop_{&RenderScheduler::SchedulerHandler, this} {}
+
+/* ********************************************************************************************** */
+
+RenderScheduler::~RenderScheduler() {
+  Stop();
+
+  if (loop_.joinable()) {
+    loop_.join();
+  }
+}
+
+/* ********************************************************************************************** */
+
+void RenderScheduler::RequestRedraw() {
+  std::scoped_lock lock(mutex_);
+  stats_.requested++;
+
+  if (in_flight_ && std::chrono::steady_clock::now() - last_redraw_ > kRedrawTimeout) {
+    LOG("Screen did not handle last redraw in time, assuming it got lost");
+    in_flight_ = false;
+  }
+
+  if (in_flight_) {
+    // Screen did not start handling the last redraw, so it will also handle this request
+    stats_.dropped++;
+    return;
+  }
+
+  if (pending_) {
+    // Already waiting for the next frame interval
+    stats_.merged++;
+    return;
+  }
+
+  pending_ = true;
+  notifier_.notify_one();
+}
+
+/* ********************************************************************************************** */
+
+void RenderScheduler::NotifyRedrawHandled() {
+  std::scoped_lock lock(mutex_);
+  if (!in_flight_) return;
+
+  in_flight_ = false;
+  notifier_.notify_one();
+}
+
+/* ********************************************************************************************** */
+
+void RenderScheduler::SetFrameRate(int value) {
+  LOG("Set maximum frame rate for screen redraws to ", value);
+  frame_rate_ = std::clamp(value, kMinFrameRate, kMaxFrameRate);
+}
+
+/* ********************************************************************************************** */
+
+void RenderScheduler::Stop() {
+  std::scoped_lock lock(mutex_);
+  exit_ = true;
+  notifier_.notify_one();
+}
+
+/* ********************************************************************************************** */
+
+RenderScheduler::Statistics RenderScheduler::GetStatistics() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+/* ********************************************************************************************** */
+
+void RenderScheduler::SchedulerHandler() {
+  LOG("Start render scheduler thread");
+
+  using std::chrono::steady_clock;
+
+  // Allow first redraw to happen right away
+  auto next_frame = steady_clock::now();
+
+  // Statistics to report real redraw rate
+  auto last_report = steady_clock::now();
+  Statistics last_stats;
+
+  std::unique_lock lock(mutex_);
+
+  while (!exit_) {
+    // Wait for a redraw request
+    notifier_.wait(lock, [this] { return exit_ || (pending_ && !in_flight_); });
+    if (exit_) break;
+
+    // And then, for the next frame interval
+    if (notifier_.wait_until(lock, next_frame, [this] { return exit_; })) break;
+
+    pending_ = false;
+    in_flight_ = true;
+    stats_.rendered++;
+
+    auto now = steady_clock::now();
+    last_redraw_ = now;
+
+    auto period = std::chrono::duration_cast<steady_clock::duration>(std::chrono::seconds(1)) /
+                  frame_rate_.load();
+
+    // If scheduler got behind for more than a whole frame, do not try to catch up
+    next_frame = (now - next_frame > period ? now : next_frame) + period;
+
+    if (now - last_report >= kReportInterval) {
+      auto seconds = std::chrono::duration<double>(now - last_report).count();
+
+      LOG("Screen redraw rate=", (stats_.rendered - last_stats.rendered) / seconds,
+          " fps (requested=", stats_.requested - last_stats.requested,
+          " merged=", stats_.merged - last_stats.merged,
+          " dropped=", stats_.dropped - last_stats.dropped, ")");
+
+      last_report = now;
+      last_stats = stats_;
+    }
+
+    // Trigger redraw without holding lock, as screen may request another redraw while handling it
+    lock.unlock();
+    redraw_();
+    lock.lock();
+  }
+
+  LOG("Finish render scheduler thread");
+}
+
+}  // namespace interface
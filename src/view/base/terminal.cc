@@ -91,6 +91,9 @@ void Terminal::Init(const std::string& initial_path) {
 void Terminal::Exit() const {
   LOG("Exit from terminal");
 
+  // Do not trigger any redraw from now on
+  if (render_scheduler_) render_scheduler_->Stop();
+
   // Trigger exit callback
   if (cb_exit_) cb_exit_();
 }
@@ -106,6 +109,10 @@ void Terminal::RegisterPlayerNotifier(const std::shared_ptr<audio::Notifier>& no
 void Terminal::RegisterEventSenderCallback(EventCallback cb) {
   cb_send_event_ = cb;
 
+  // Every redraw requested by a custom event is scheduled, so they never exceed the frame rate
+  render_scheduler_ = std::make_unique<RenderScheduler>(
+      [this] { cb_send_event_(ftxui::Event::Custom); }, frame_rate_);
+
   // Force a refresh to handle any pending custom event
   // (this is necessary, in order to update UI with volume information)
   cb_send_event_(ftxui::Event::Custom);
@@ -117,6 +124,13 @@ void Terminal::RegisterExitCallback(Callback cb) { cb_exit_ = cb; }
 
 /* ********************************************************************************************** */
 
+void Terminal::SetFrameRate(int value) {
+  frame_rate_ = value;
+  if (render_scheduler_) render_scheduler_->SetFrameRate(value);
+}
+
+/* ********************************************************************************************** */
+
 ftxui::Element Terminal::Render() {
   if (children_.empty() || children_.size() != 4) {
     ERROR("Terminal is empty, it has no child block");
@@ -127,6 +141,7 @@ ftxui::Element Terminal::Render() {
   if (auto current_size = ftxui::Terminal::Size(); size_ != current_size) {
     LOG("Resize terminal with new value={x:", current_size.dimx, " y:", current_size.dimy, "}");
     size_ = current_size;
+    SetBlocksDirty();
 
     // Recalculate maximum number of bars to show in spectrum graphic
     int number_bars = CalculateNumberBars();
@@ -139,11 +154,11 @@ ftxui::Element Terminal::Render() {
   ftxui::Element terminal;
 
   if (!fullscreen_mode_) {
-    // Render each block
-    ftxui::Element sidebar = children_.at(kBlockSidebar)->Render();
-    ftxui::Element file_info = children_.at(kBlockFileInfo)->Render();
-    ftxui::Element tab_viewer = children_.at(kBlockMainContent)->Render();
-    ftxui::Element media_player = children_.at(kBlockMediaPlayer)->Render();
+    // Render each block (only the ones with some change since last frame are built again)
+    ftxui::Element sidebar = RenderBlock(kBlockSidebar);
+    ftxui::Element file_info = RenderBlock(kBlockFileInfo);
+    ftxui::Element tab_viewer = RenderBlock(kBlockMainContent);
+    ftxui::Element media_player = RenderBlock(kBlockMediaPlayer);
 
     // Glue everything together
     terminal = ftxui::hbox({
@@ -171,6 +186,9 @@ bool Terminal::OnEvent(ftxui::Event event) {
   // Treat any pending custom event
   OnCustomEvent();
 
+  // Any event from mouse/keyboard may change state from any block (e.g. focus, hover, selection)
+  if (event != ftxui::Event::Custom) SetBlocksDirty();
+
   // Cannot do anything while dialog box is opened
   if (error_dialog_->IsVisible()) return error_dialog_->OnEvent(event);
 
@@ -240,6 +258,9 @@ void Terminal::OnCustomEvent() {
                                                    CustomEvent::Identifier::Refresh,
                                                    CustomEvent::Identifier::SetFocused};
 
+  // Every event sent until now is handled below, so any event sent afterwards needs a new redraw
+  if (render_scheduler_) render_scheduler_->NotifyRedrawHandled();
+
   while (receiver_->HasPending()) {
     CustomEvent event;
     if (!receiver_->Receive(&event)) break;
@@ -269,7 +290,12 @@ void Terminal::OnCustomEvent() {
     // Otherwise, send it to children blocks
     for (const auto& child : children_) {
       auto block = std::static_pointer_cast<Block>(child);
-      if (block->OnCustomEvent(event)) {
+      bool handled = block->OnCustomEvent(event);
+
+      // Only render block again if event may have changed its content
+      if (block->IsAffectedBy(event)) block->SetDirty();
+
+      if (handled) {
         break;  // Skip to next event
       }
     }
@@ -414,7 +440,7 @@ bool Terminal::HandleEventFromInterfaceToAudioThread(const CustomEvent& event) {
 
       // Update UI with new size
       auto event_bars =
-          interface::CustomEvent::DrawAudioSpectrum(std::vector<double>(content, 0.001));
+          interface::CustomEvent::DrawAudioSpectrum(model::AudioSpectrum(content, 0.001));
       ProcessEvent(event_bars);
     } break;
 
@@ -429,13 +455,13 @@ bool Terminal::HandleEventFromInterfaceToAudioThread(const CustomEvent& event) {
     } break;
 
     case CustomEvent::Identifier::ApplyAudioFilters: {
-      auto content = event.GetContent<model::EqualizerPreset>();
+      const auto& content = event.GetContentRef<model::EqualizerPreset>();
       media_ctl->ApplyAudioFilters(content);
     } break;
 
     case CustomEvent::Identifier::NotifyPlaylistSelection: {
-      auto content = event.GetContent<model::Playlist>();
-      media_ctl->NotifyPlaylistSelection(content);
+      auto content = event.GetSharedContent<model::Playlist>();
+      if (content) media_ctl->NotifyPlaylistSelection(content);
     } break;
 
     default:
@@ -505,6 +531,7 @@ bool Terminal::HandleEventFromInterfaceToInterface(const CustomEvent& event) {
 
     case CustomEvent::Identifier::ToggleFullscreen: {
       fullscreen_mode_ = !fullscreen_mode_;
+      SetBlocksDirty();
 
       // Recalculate maximum number of bars to show in spectrum graphic
       int number_bars = CalculateNumberBars();
@@ -520,7 +547,7 @@ bool Terminal::HandleEventFromInterfaceToInterface(const CustomEvent& event) {
     } break;
 
     case CustomEvent::Identifier::ShowQuestionDialog: {
-      const auto& content = event.GetContent<model::QuestionData>();
+      const auto& content = event.GetContentRef<model::QuestionData>();
       question_dialog_->SetMessage(content);
       question_dialog_->Open();
     } break;
@@ -541,7 +568,9 @@ bool Terminal::HandleEventFromInterfaceToInterface(const CustomEvent& event) {
 
 void Terminal::SendEvent(const CustomEvent& event) {
   sender_->Send(event);
-  cb_send_event_(ftxui::Event::Custom);  // force a refresh
+
+  // Request a refresh, which may be merged with others (screen handles all pending events at once)
+  if (render_scheduler_) render_scheduler_->RequestRedraw();
 }
 
 /* ********************************************************************************************** */
@@ -614,6 +643,18 @@ void Terminal::UpdateFocus(int old_index, int new_index) {
 
 /* ********************************************************************************************** */
 
+void Terminal::SetBlocksDirty() {
+  for (const auto& child : children_) std::static_pointer_cast<Block>(child)->SetDirty();
+}
+
+/* ********************************************************************************************** */
+
+ftxui::Element Terminal::RenderBlock(int index) {
+  return std::static_pointer_cast<Block>(children_.at(index))->RenderCached();
+}
+
+/* ********************************************************************************************** */
+
 ftxui::Element Terminal::GetOverlay() const {
   if (error_dialog_->IsVisible()) return error_dialog_->Render(size_);
 
@@ -0,0 +1,97 @@
+#include "view/base/ticker.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace interface {
+
+Ticker::~Ticker() {
+  {
+    std::scoped_lock lock(mutex_);
+    exit_ = true;
+    notifier_.notify_all();
+  }
+
+  if (loop_.joinable()) {
+    loop_.join();
+  }
+}
+
+/* ********************************************************************************************** */
+
+Ticker::Id Ticker::Register(std::chrono::milliseconds interval, Callback callback) {
+  std::scoped_lock lock(mutex_);
+
+  // Spawn thread only when there is something to run
+  if (!loop_.joinable()) loop_ = std::thread(&Ticker::TickerHandler, this);
+
+  Id id = next_id_++;
+  timers_.emplace(id, Timer{
+                          .interval = interval,
+                          .deadline = std::chrono::steady_clock::now() + interval,
+                          .callback = std::move(callback),
+                      });
+
+  // Ticker thread may be sleeping until a later deadline
+  notifier_.notify_all();
+  return id;
+}
+
+/* ********************************************************************************************** */
+
+void Ticker::Unregister(Id id) {
+  std::unique_lock lock(mutex_);
+  timers_.erase(id);
+
+  // Callback may be using resources from its owner, so it must not run after this returns (but it
+  // cannot wait for itself, when unregistering from ticker thread)
+  if (std::this_thread::get_id() != loop_.get_id()) {
+    notifier_.wait(lock, [this, id] { return running_ != id; });
+  }
+}
+
+/* ********************************************************************************************** */
+
+void Ticker::TickerHandler() {
+  std::unique_lock lock(mutex_);
+
+  while (!exit_) {
+    if (timers_.empty()) {
+      notifier_.wait(lock);
+      continue;
+    }
+
+    // Sleep until the earliest deadline (or until a new callback is registered)
+    auto earliest = std::min_element(timers_.begin(), timers_.end(), [](auto& a, auto& b) {
+      return a.second.deadline < b.second.deadline;
+    });
+
+    auto deadline = earliest->second.deadline;
+
+    if (std::chrono::steady_clock::now() < deadline) {
+      notifier_.wait_until(lock, deadline);
+      continue;
+    }
+
+    // Run callback without lock, as it may register or unregister callbacks too
+    Id id = earliest->first;
+    Callback callback = earliest->second.callback;
+    running_ = id;
+
+    lock.unlock();
+    callback();
+    lock.lock();
+
+    running_ = 0;
+    notifier_.notify_all();
+
+    // Schedule next call (skipping any deadline already missed, instead of running it in a burst)
+    if (auto timer = timers_.find(id); timer != timers_.end()) {
+      auto now = std::chrono::steady_clock::now();
+      timer->second.deadline += timer->second.interval;
+      if (timer->second.deadline < now) timer->second.deadline = now + timer->second.interval;
+    }
+  }
+}
+
+}  // namespace interface
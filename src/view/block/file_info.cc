@@ -69,7 +69,7 @@ bool FileInfo::OnCustomEvent(const CustomEvent& event) {
   // Do not return true because other blocks may use it
   if (event == CustomEvent::Identifier::UpdateSongInfo) {
     LOG("Received new song information from player");
-    ParseAudioInfo(event.GetContent<model::Song>());
+    ParseAudioInfo(event.GetContentRef<model::Song>());
   }
 
   return false;
@@ -77,6 +77,13 @@ bool FileInfo::OnCustomEvent(const CustomEvent& event) {
 
 /* ********************************************************************************************** */
 
+bool FileInfo::IsAffectedBy(const CustomEvent& event) const {
+  return event == CustomEvent::Identifier::ClearSongInfo ||
+         event == CustomEvent::Identifier::UpdateSongInfo;
+}
+
+/* ********************************************************************************************** */
+
 void FileInfo::ParseAudioInfo(const model::Song& audio) {
   audio_info_.clear();
   is_song_playing_ = !audio.IsEmpty();
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <optional>
 #include <string>
+#include <utility>
 
 #include "audio/lyric/lyric_finder.h"
 #include "ftxui/dom/elements.hpp"
@@ -15,11 +16,24 @@ namespace interface {
 SongLyric::SongLyric(const model::BlockIdentifier& id,
                      const std::shared_ptr<EventDispatcher>& dispatcher,
                      const FocusCallback& on_focus, const keybinding::Key& keybinding)
-    : TabItem(id, dispatcher, on_focus, keybinding, std::string{kTabName}) {}
+    : TabItem(id, dispatcher, on_focus, keybinding, std::string{kTabName}),
+      fetcher_{&SongLyric::FetcherHandler, this} {}
 
 /* ********************************************************************************************** */
 
-SongLyric::~SongLyric() { async_fetcher_.reset(); }
+SongLyric::~SongLyric() {
+  {
+    std::scoped_lock lock(mutex_);
+    exit_ = true;
+    cancelled_ = true;
+    notifier_.notify_one();
+  }
+
+  // Any fetch executing is aborted right away, so this does not take long
+  if (fetcher_.joinable()) {
+    fetcher_.join();
+  }
+}
 
 /* ********************************************************************************************** */
 
@@ -35,11 +49,8 @@ ftxui::Element SongLyric::Render() {
     return ftxui::text("Fetching lyrics...") | style;
   }
 
-  if (IsResultReady()) {
-    // It is not that great to have this inside Render(), but it is working fine...
-    // TODO: Must rethink this in the near "future"
-    // Use something like producer/consumer and remove std::future
-    if (auto result = async_fetcher_->get(); result) lyrics_ = *result;
+  if (auto result = TakeResult(); result && *result) {
+    lyrics_ = std::move(**result);
   }
 
   if (lyrics_.empty()) {
@@ -88,7 +99,7 @@ bool SongLyric::OnCustomEvent(const CustomEvent& event) {
   if (event == CustomEvent::Identifier::ClearSongInfo) {
     LOG("Clear current song information");
     audio_info_ = model::Song{};
-    async_fetcher_.reset();
+    RequestFetch(std::nullopt);
     lyrics_.clear();
     focused_ = 0;
   }
@@ -96,13 +107,11 @@ bool SongLyric::OnCustomEvent(const CustomEvent& event) {
   // Do not return true because other blocks may use it
   if (event == CustomEvent::Identifier::UpdateSongInfo) {
     LOG("Received new song information from player");
-    audio_info_ = event.GetContent<model::Song>();
+    audio_info_ = event.GetContentRef<model::Song>();
 
     if (!audio_info_.filepath.empty()) {
-      LOG("Launch async task to fetch song lyrics");
-      // TODO: this is not good, must change to another permanent running thread
-      async_fetcher_ = std::make_unique<std::future<FetchResult>>(
-          std::async(std::launch::async, std::bind(&SongLyric::FetchSongLyrics, this)));
+      LOG("Request fetcher thread to fetch song lyrics");
+      RequestFetch(audio_info_);
     }
   }
 
@@ -111,18 +120,80 @@ bool SongLyric::OnCustomEvent(const CustomEvent& event) {
 
 /* ********************************************************************************************** */
 
-SongLyric::FetchResult SongLyric::FetchSongLyrics() {
-  LOG("Started executing thread to fetch song lyrics");
+bool SongLyric::IsFetching() {
+  std::scoped_lock lock(mutex_);
+  return request_.has_value() || fetching_;
+}
+
+/* ********************************************************************************************** */
+
+std::optional<SongLyric::FetchResult> SongLyric::TakeResult() {
+  std::scoped_lock lock(mutex_);
+  return std::exchange(result_, std::nullopt);
+}
+
+/* ********************************************************************************************** */
+
+void SongLyric::RequestFetch(const std::optional<model::Song>& song) {
+  std::scoped_lock lock(mutex_);
+
+  // Result from fetch executing (or already finished) belongs to the previous song
+  request_ = song;
+  result_.reset();
+  cancelled_ = true;
+
+  notifier_.notify_one();
+}
+
+/* ********************************************************************************************** */
+
+void SongLyric::FetcherHandler() {
+  std::unique_lock lock(mutex_);
+
+  while (true) {
+    notifier_.wait(lock, [this] { return exit_ || request_.has_value(); });
+    if (exit_) break;
+
+    model::Song song = std::move(*request_);
+    request_.reset();
+    cancelled_ = false;
+    fetching_ = true;
+
+    // Fetch without lock, so a new request may cancel it at any time
+    lock.unlock();
+    FetchResult result = FetchSongLyrics(song);
+    lock.lock();
+
+    fetching_ = false;
+
+    // Discard result if song changed (or got cleared) in the meantime
+    if (cancelled_) continue;
+
+    result_ = std::move(result);
+
+    // Otherwise, UI would keep showing that it is still fetching until something else redraws it
+    lock.unlock();
+    if (auto dispatcher = dispatcher_.lock(); dispatcher) {
+      dispatcher->SendEvent(CustomEvent::Refresh());
+    }
+    lock.lock();
+  }
+}
+
+/* ********************************************************************************************** */
+
+SongLyric::FetchResult SongLyric::FetchSongLyrics(const model::Song& song) {
+  LOG("Started fetching song lyrics");
 
   std::string artist;
   std::string title;
 
-  if (!audio_info_.artist.empty() && !audio_info_.title.empty()) {
+  if (!song.artist.empty() && !song.title.empty()) {
     LOG("Getting information from audio metadata");
-    artist = audio_info_.artist;
-    title = audio_info_.title;
+    artist = song.artist;
+    title = song.title;
   } else {
-    std::string filepath = audio_info_.filepath;
+    std::string filepath = song.filepath;
     LOG("Getting information from audio filepath=", filepath);
 
     size_t pos = filepath.find_last_of('/');
@@ -155,10 +226,12 @@ SongLyric::FetchResult SongLyric::FetchSongLyrics() {
     return std::nullopt;
   }
 
-  FetchResult result = finder_->Search(artist, title);
+  FetchResult result = finder_->Search(artist, title, cancelled_);
 
   if (!result.value().empty()) {
     LOG("Found song lyrics");
+  } else if (cancelled_) {
+    LOG("Cancelled fetching song lyrics");
   } else {
     ERROR("Failed to fetch song lyrics");
   }
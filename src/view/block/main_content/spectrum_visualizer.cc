@@ -1,9 +1,13 @@
 #include "view/block/main_content/spectrum_visualizer.h"
 
 #include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
 
 #include "util/logger.h"
 #include "view/base/keybinding.h"
+#include "view/element/spectrum.h"
 
 namespace interface {
 
@@ -16,6 +20,28 @@ SpectrumVisualizer::SpectrumVisualizer(const model::BlockIdentifier& id,
 /* ********************************************************************************************** */
 
 ftxui::Element SpectrumVisualizer::Render() {
+  // Take the most recent frame published by audio analysis (if any). As front buffer is owned by
+  // this class until next update, simply swap it with the current target instead of copying it
+  if (shared_spectrum_ && shared_spectrum_->Update()) {
+    target_.swap(shared_spectrum_->GetFrontBuffer());
+
+    // Bars are interpolated from their current values until next frame is expected to arrive
+    auto now = std::chrono::steady_clock::now();
+    frame_interval_ = std::clamp<std::chrono::steady_clock::duration>(
+        now - target_time_, kMinFrameInterval, kMaxFrameInterval);
+    target_time_ = now;
+    previous_ = spectrum_data_;
+  }
+
+  // Keep asking for redraws while bars are still moving, as audio analysis may send frames at a
+  // lower rate than the screen refresh rate (or even stop sending them, like after a pause)
+  if (bool moving = AnimateBars(); moving && shared_spectrum_) {
+    if (auto dispatcher = dispatcher_.lock(); dispatcher) {
+      auto event = CustomEvent::DrawAudioSpectrum(shared_spectrum_);
+      dispatcher->SendEvent(event);
+    }
+  }
+
   ftxui::Element bar_visualizer = ftxui::text("");
 
   switch (curr_anim_) {
@@ -50,6 +76,7 @@ bool SpectrumVisualizer::OnEvent(const ftxui::Event& event) {
     if (!dispatcher) return false;
 
     spectrum_data_.clear();
+    target_.clear();
     curr_anim_ = curr_anim_ < model::BarAnimation::Mono
                      ? static_cast<model::BarAnimation>(curr_anim_ + 1)  // get next
                      : model::BarAnimation::HorizontalMirror;            // reset to first one
@@ -104,7 +131,15 @@ bool SpectrumVisualizer::OnEvent(const ftxui::Event& event) {
 bool SpectrumVisualizer::OnCustomEvent(const CustomEvent& event) {
   // Store spectrum audio data to render later
   if (event == CustomEvent::Identifier::DrawAudioSpectrum) {
-    spectrum_data_ = event.GetContent<std::vector<double>>();
+    // Event only notifies that a new frame is available, so it will be read from shared frames
+    if (auto frames = event.GetContent<std::shared_ptr<model::SharedSpectrum>>(); frames) {
+      shared_spectrum_ = std::move(frames);
+    } else {
+      // Spectrum not coming from audio analysis (e.g. after resizing it) is drawn right away
+      target_ = event.GetContentRef<model::AudioSpectrum>();
+      spectrum_data_ = target_;
+    }
+
     return true;
   }
 
@@ -132,25 +167,41 @@ bool SpectrumVisualizer::OnCustomEvent(const CustomEvent& event) {
 
 /* ********************************************************************************************** */
 
-void SpectrumVisualizer::CreateGauge(double value, ftxui::Direction direction,
-                                     ftxui::Elements& elements) const {
-  using ftxui::gaugeDirection;
-  constexpr auto color = [](const ftxui::Direction& dir) {
-    auto gradient = ftxui::LinearGradient()
-                        .Angle(dir == ftxui::Direction::Up ? 270 : 90)
-                        .Stop(ftxui::Color(95, 135, 215), 0.0f)
-                        .Stop(ftxui::Color(115, 155, 215), 0.3f)
-                        .Stop(ftxui::Color(155, 188, 235), 0.6f)
-                        .Stop(ftxui::Color(185, 208, 252), 0.8f);
-
-    return ftxui::color(gradient);
-  };
+bool SpectrumVisualizer::AnimateBars() {
+  using std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<model::Sample>;
 
-  for (int i = 0; i < gauge_width_; i++) {
-    elements.push_back(gaugeDirection(static_cast<float>(value), direction) | color(direction));
+  auto now = steady_clock::now();
+  auto elapsed = std::min<steady_clock::duration>(now - last_render_, kMaxFrameInterval);
+  last_render_ = now;
+
+  // Nothing to animate from (e.g. spectrum got resized), so simply draw target bars
+  if (spectrum_data_.size() != target_.size() || previous_.size() != target_.size()) {
+    spectrum_data_ = target_;
+    previous_ = target_;
+    fall_speed_.assign(target_.size(), 0);
+    return false;
+  }
+
+  model::Sample delta = Seconds(elapsed).count();
+  model::Sample progress = Seconds(now - target_time_) / Seconds(frame_interval_);
+  bool moving = false;
+
+  for (size_t i = 0; i < target_.size(); i++) {
+    model::Sample& value = spectrum_data_[i];
+
+    if (target_[i] >= previous_[i]) {
+      value = progress < 1 ? previous_[i] + (target_[i] - previous_[i]) * progress : target_[i];
+      fall_speed_[i] = 0;
+    } else {
+      fall_speed_[i] += kGravity * delta;
+      value = std::max(target_[i], value - fall_speed_[i] * delta);
+    }
+
+    moving |= value != target_[i];
   }
 
-  elements.push_back(ftxui::text(std::string(kGaugeSpacing, ' ')));
+  return moving;
 }
 
 /* ********************************************************************************************** */
@@ -159,24 +210,19 @@ void SpectrumVisualizer::DrawAnimationHorizontalMirror(ftxui::Element& visualize
   auto size = (int)spectrum_data_.size();
   if (size == 0) return;
 
-  ftxui::Elements entries;
+  SpectrumBars bars;
+  bars.values.reserve(size);
 
-  // Preallocate memory
-  int total_size = size * (kGaugeDefaultWidth + kGaugeSpacing);
-  entries.reserve(total_size);
+  // Left channel is mirrored, so its lowest frequencies meet the ones from right channel in the
+  // middle of the screen
+  bars.values.insert(bars.values.end(), spectrum_data_.rbegin() + (size - size / 2),
+                     spectrum_data_.rend());
+  bars.values.insert(bars.values.end(), spectrum_data_.begin() + size / 2, spectrum_data_.end());
 
-  for (int i = (size / 2) - 1; i >= 0; i--) {
-    CreateGauge(spectrum_data_[i], ftxui::Direction::Up, entries);
-  }
+  std::vector<SpectrumBars> rows;
+  rows.push_back(std::move(bars));
 
-  for (int i = size / 2; i < size; i++) {
-    CreateGauge(spectrum_data_[i], ftxui::Direction::Up, entries);
-  }
-
-  // Remove last empty space
-  entries.pop_back();
-
-  visualizer = ftxui::hbox(entries) | ftxui::hcenter;
+  visualizer = Spectrum(std::move(rows), gauge_width_, kGaugeSpacing);
 }
 
 /* ********************************************************************************************** */
@@ -185,28 +231,16 @@ void SpectrumVisualizer::DrawAnimationVerticalMirror(ftxui::Element& visualizer)
   auto size = (int)spectrum_data_.size();
   if (size == 0) return;
 
-  ftxui::Elements left;
-  ftxui::Elements right;
-
-  // Preallocate memory
-  int total_size = (size / 2) * (kGaugeDefaultWidth + kGaugeSpacing);
-  left.reserve(total_size);
-  right.reserve(total_size);
-
-  for (int i = 0; i < size / 2; i++) {
-    CreateGauge(spectrum_data_[i], ftxui::Direction::Up, left);
-  }
-
-  for (int i = size / 2; i < size; i++) {
-    CreateGauge(spectrum_data_[i], ftxui::Direction::Down, right);
-  }
-
-  // Remove last empty space
-  left.pop_back();
-  right.pop_back();
+  // Left channel on top and right channel (upside down) on bottom
+  std::vector<SpectrumBars> rows{
+      SpectrumBars{.values = model::AudioSpectrum(spectrum_data_.begin(),
+                                                  spectrum_data_.begin() + size / 2)},
+      SpectrumBars{.values = model::AudioSpectrum(spectrum_data_.begin() + size / 2,
+                                                  spectrum_data_.end()),
+                   .upside_down = true},
+  };
 
-  visualizer = ftxui::vbox(ftxui::hbox(left) | ftxui::hcenter | ftxui::yflex,
-                           ftxui::hbox(right) | ftxui::hcenter | ftxui::yflex);
+  visualizer = Spectrum(std::move(rows), gauge_width_, kGaugeSpacing);
 }
 
 /* ********************************************************************************************** */
@@ -219,35 +253,19 @@ void SpectrumVisualizer::DrawAnimationMono(ftxui::Element& visualizer) {
   // channels, so divide size by 2
   size /= 2;
 
-  // Split data by channel
-  std::vector<double>::const_iterator first = spectrum_data_.begin();
-  std::vector<double>::const_iterator middle = spectrum_data_.begin() + size;
-  std::vector<double>::const_iterator last = spectrum_data_.end();
-
-  std::vector<double> left(first, middle);
-  std::vector<double> right(middle, last);
-  std::vector<double> average(size, 0);
+  SpectrumBars bars;
+  bars.values.resize(size);
 
   // Get average of each frequency from channels
-  std::transform(left.begin(), left.end(),  // Left channel
-                 right.begin(),             // Right channel
-                 average.begin(),           // Average of the sum from both
-                 [](double a, double b) { return (a + b) / 2; });
-
-  ftxui::Elements entries;
-
-  // Preallocate memory
-  int total_size = size * (kGaugeDefaultWidth + kGaugeSpacing);
-  entries.reserve(total_size);
-
-  for (int i = 0; i < size; i++) {
-    CreateGauge(spectrum_data_[i], ftxui::Direction::Up, entries);
-  }
+  std::transform(spectrum_data_.begin(), spectrum_data_.begin() + size,  // Left channel
+                 spectrum_data_.begin() + size,                          // Right channel
+                 bars.values.begin(),  // Average of the sum from both
+                 [](model::Sample a, model::Sample b) { return (a + b) / 2; });
 
-  // Remove last empty space
-  entries.pop_back();
+  std::vector<SpectrumBars> rows;
+  rows.push_back(std::move(bars));
 
-  visualizer = ftxui::hbox(entries) | ftxui::hcenter;
+  visualizer = Spectrum(std::move(rows), gauge_width_, kGaugeSpacing);
 }
 
 }  // namespace interface
@@ -205,7 +205,7 @@ bool MediaPlayer::OnCustomEvent(const CustomEvent& event) {
   // Do not return true because other blocks may use it
   if (event == CustomEvent::Identifier::UpdateSongInfo) {
     LOG("Received new song information from player");
-    song_ = event.GetContent<model::Song>();
+    song_ = event.GetContentRef<model::Song>();
   }
 
   // Do not return true because other blocks may use it
@@ -219,6 +219,13 @@ bool MediaPlayer::OnCustomEvent(const CustomEvent& event) {
 
 /* ********************************************************************************************** */
 
+bool MediaPlayer::IsAffectedBy(const CustomEvent& event) const {
+  // Audio spectrum is the most frequent event, and it is only drawn by MainContent block
+  return event != CustomEvent::Identifier::DrawAudioSpectrum;
+}
+
+/* ********************************************************************************************** */
+
 bool MediaPlayer::OnMouseEvent(ftxui::Event event) {
   // Media buttons
   if (btn_previous_->OnMouseEvent(event)) return true;
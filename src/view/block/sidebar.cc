@@ -89,8 +89,9 @@ bool Sidebar::OnEvent(ftxui::Event event) {
 /* ********************************************************************************************** */
 
 bool Sidebar::OnCustomEvent(const CustomEvent& event) {
-  // Process this event for all tab items
-  if (event == CustomEvent::Identifier::UpdateSongInfo) {
+  // Process this event for all tab items (even when not visible, to keep their content updated)
+  if (event == CustomEvent::Identifier::UpdateSongInfo ||
+      event == CustomEvent::Identifier::Refresh) {
     for (const auto& [id, item] : tab_elem_.items()) item->OnCustomEvent(event);
     return false;
   }
@@ -100,6 +101,14 @@ bool Sidebar::OnCustomEvent(const CustomEvent& event) {
 
 /* ********************************************************************************************** */
 
+bool Sidebar::IsAffectedBy(const CustomEvent& event) const {
+  // Neither audio spectrum nor song position are shown by any tab item (and both are frequent)
+  return event != CustomEvent::Identifier::DrawAudioSpectrum &&
+         event != CustomEvent::Identifier::UpdateSongState;
+}
+
+/* ********************************************************************************************** */
+
 void Sidebar::OnFocus() {
   // Update internal state for all buttons
   for (const auto& [id, item] : tab_elem_.items()) item->GetButton()->UpdateParentFocus(true);
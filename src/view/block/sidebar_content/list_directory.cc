@@ -77,11 +77,17 @@ bool ListDirectory::OnMouseEvent(ftxui::Event& event) {
 /* ********************************************************************************************** */
 
 bool ListDirectory::OnCustomEvent(const CustomEvent& event) {
+  if (event == CustomEvent::Identifier::Refresh) {
+    // Entries may have been listed (or changed) in background, so apply them before next render
+    menu_->actual().ApplyPendingChanges();
+    return false;
+  }
+
   if (event == CustomEvent::Identifier::UpdateSongInfo) {
     LOG("Received new song information from player");
 
     // Set current song
-    curr_playing_ = event.GetContent<model::Song>().filepath;
+    curr_playing_ = event.GetContentRef<model::Song>().filepath;
 
     // Update highlighted entry in menu
     menu_->ResetSearch();
@@ -178,28 +184,27 @@ util::File ListDirectory::SelectFileToPlay(bool is_next) {
   if (size <= 2) return util::File{};
 
   // Get index from current song playing
+  auto is_playing = [this](const util::FileEntry& entry) { return entry.path == *curr_playing_; };
   int index = static_cast<int>(
-      std::distance(entries.begin(), std::find(entries.begin(), entries.end(), *curr_playing_)));
+      std::distance(entries.begin(), std::find_if(entries.begin(), entries.end(), is_playing)));
 
   int new_index = is_next ? (index + 1) % size : (index + size - 1) % size;
   int attempts = size;
-  util::File file;
 
   // Iterate circularly through all file entries
-  bool found = false;
-  for (file = entries[new_index]; attempts > 0; --attempts, file = entries[new_index]) {
+  for (; attempts > 0; --attempts) {
     // TODO: create API on decoder to check if this file contains an audio stream
+    const auto& file = entries[new_index];
 
-    // Found a possible file to play
-    if (new_index != 0 && file != *curr_playing_ && !std::filesystem::is_directory(file)) {
-      found = true;
-      break;
+    // Found a possible file to play (using cached type, instead of querying filesystem)
+    if (new_index != 0 && !is_playing(file) && !file.IsDirectory()) {
+      return file.path;
     }
 
     new_index = is_next ? (new_index + 1) % size : (new_index + size - 1) % size;
   }
 
-  return found ? file : util::File{};
+  return util::File{};
 }
 
 }  // namespace interface
@@ -153,7 +153,7 @@ bool PlaylistViewer::OnCustomEvent(const CustomEvent& event) {
     LOG("Received new playlist song information from player");
 
     // Set current song
-    auto current_song = event.GetContent<model::Song>();
+    const auto& current_song = event.GetContentRef<model::Song>();
     menu_->SetEntryHighlighted(current_song);
   }
 
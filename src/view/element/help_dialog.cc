@@ -105,6 +105,7 @@ ftxui::Element HelpDialog::BuildGeneralInfo() const {
               command("Home", "Go to first entry"),
               command("End", "Go to last entry"),
               command("/", "Enter search mode"),
+              command("?", "Enter search mode on library"),
               command("Esc", "Cancel search mode (when focused)"),
               command("Return", "Enter directory/play song"),
 
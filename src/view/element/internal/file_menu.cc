@@ -1,6 +1,9 @@
 #include "view/element/internal/file_menu.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
+#include <unordered_set>
 
 #include "ftxui/component/component.hpp"
 #include "ftxui/dom/elements.hpp"
@@ -15,7 +18,10 @@ FileMenu::FileMenu(const std::shared_ptr<EventDispatcher>& dispatcher,
                    const std::shared_ptr<util::FileHandler>& file_handler,
                    const TextAnimation::Callback& force_refresh, const Callback& on_click,
                    const menu::Style& style, const std::string& optional_path)
-    : BaseMenu(dispatcher, force_refresh), file_handler_{file_handler}, on_click_{on_click} {
+    : BaseMenu(dispatcher, force_refresh),
+      on_click_{on_click},
+      file_handler_{file_handler},
+      force_refresh_{force_refresh} {
   switch (style) {
     case menu::Style::Default:
       style_ = Style{
@@ -42,70 +48,87 @@ FileMenu::FileMenu(const std::shared_ptr<EventDispatcher>& dispatcher,
     // If we can't list files from current path, then everything is gone
     RefreshList(std::filesystem::current_path());
   }
+
+  // Global search looks for files under the initial directory
+  library_root_ = curr_dir_;
 }
 
 /* ********************************************************************************************** */
 
 ftxui::Element FileMenu::RenderImpl() {
+  ftxui::Elements content{
+      RenderEntries() | ftxui::flex,
+  };
+
+  // Append search box, if enabled
+  if (IsSearchEnabled()) {
+    content.push_back(RenderSearch());
+  }
+
+  auto title = ftxui::text(GetTitle()) | ftxui::color(ftxui::Color::White) | ftxui::bold;
+
+  // Show that directory is still being listed (or library is still being indexed)
+  bool is_indexing = global_search_ && library_->IsUpdating();
+
+  if (IsLoading() || is_indexing) {
+    title = ftxui::hbox({
+        title | ftxui::xflex,
+        ftxui::text(IsLoading() ? " loading..." : " indexing...") |
+            ftxui::color(ftxui::Color::Grey50),
+    });
+  }
+
+  return ftxui::vbox({
+             title,
+             ftxui::vbox(content) | ftxui::flex,
+         }) |
+         ftxui::flex;
+}
+
+/* ********************************************************************************************** */
+
+ftxui::Elements FileMenu::RenderEntriesImpl(int first, int last) {
   using ftxui::EQUAL;
   using ftxui::WIDTH;
 
   auto max_size = GetMaxColumns() ? ftxui::size(WIDTH, EQUAL, GetMaxColumns()) : ftxui::nothing;
 
   ftxui::Elements menu_entries;
-
-  int size = GetSize();
-  menu_entries.reserve(size);
+  menu_entries.reserve(last - first);
 
   const auto selected = GetSelected();
   const auto focused = GetFocused();
-  auto& boxes = GetBoxes();
 
-  // Fill list with entries
-  for (int i = 0; i < size; ++i) {
-    const auto& entry = IsSearchEnabled() ? filtered_entries_->at(i) : entries_.at(i);
+  // Fill list only with entries visible on screen
+  for (int i = first; i < last; ++i) {
+    const auto& entry = GetEntryAt(i);
 
     bool is_focused = (*focused == i);
     bool is_selected = (*selected == i);
-    bool is_highlighted = highlighted_ && entry == *highlighted_;
+    bool is_highlighted = highlighted_ && entry.path == *highlighted_;
 
-    const auto& type = is_highlighted                         ? style_.playing
-                       : std::filesystem::is_directory(entry) ? style_.directory
-                                                              : style_.file;
+    const auto& type = is_highlighted        ? style_.playing
+                       : entry.IsDirectory() ? style_.directory
+                                             : style_.file;
 
     auto prefix = ftxui::text(is_selected ? "▶ " : "  ");
 
     ftxui::Decorator style = is_selected ? (is_focused ? type.selected_focused : type.selected)
                                          : (is_focused ? type.focused : type.normal);
 
-    auto focus_management = is_focused ? ftxui::select : ftxui::nothing;
-
     // In case of entry text too long, animation thread will be running, so we gotta take the
     // text content from there
     auto text = ftxui::text(IsAnimationRunning() && is_selected ? GetTextFromAnimation()
-                                                                : entry.filename().string());
+                                                                : GetEntryText(entry));
 
     menu_entries.push_back(ftxui::hbox({
                                prefix | style_.prefix,
                                text | style | ftxui::xflex,
                            }) |
-                           max_size | focus_management | ftxui::reflect(boxes[i]));
-  }
-
-  ftxui::Elements content{
-      ftxui::vbox(menu_entries) | ftxui::reflect(Box()) | ftxui::frame | ftxui::flex,
-  };
-
-  // Append search box, if enabled
-  if (IsSearchEnabled()) {
-    content.push_back(RenderSearch());
+                           max_size);
   }
 
-  return ftxui::vbox({
-             ftxui::text(GetTitle()) | ftxui::color(ftxui::Color::White) | ftxui::bold,
-             ftxui::vbox(content) | ftxui::flex,
-         }) |
-         ftxui::flex;
+  return menu_entries;
 }
 
 /* ********************************************************************************************** */
@@ -117,12 +140,20 @@ bool FileMenu::OnEventImpl(const ftxui::Event& event) {
     return true;
   }
 
+  // Enable search mode on whole library
+  if (!IsSearchEnabled() && event == keybinding::Navigation::EnableGlobalSearch) {
+    EnableGlobalSearch();
+    return true;
+  }
+
   return false;
 }
 
 /* ********************************************************************************************** */
 
 int FileMenu::GetSizeImpl() const {
+  if (global_search_) return (int)global_entries_.size();
+
   int size = IsSearchEnabled() ? (int)filtered_entries_->size() : (int)entries_.size();
   return size;
 }
@@ -130,25 +161,25 @@ int FileMenu::GetSizeImpl() const {
 /* ********************************************************************************************** */
 
 std::string FileMenu::GetActiveEntryAsTextImpl() const {
-  auto active = GetActiveEntryImpl();
-  return active.has_value() ? active->filename().string() : "";
+  const util::FileEntry* active = GetActiveFileEntry();
+  return active ? GetEntryText(*active) : "";
 }
 
 /* ********************************************************************************************** */
 
 bool FileMenu::OnClickImpl() {
-  auto active = GetActiveEntryImpl();
+  const util::FileEntry* active = GetActiveFileEntry();
 
-  if (!active.has_value()) return false;
+  if (!active) return false;
 
   std::filesystem::path new_dir;
 
-  if (active->filename() == ".." && std::filesystem::exists(curr_dir_.parent_path())) {
+  if (active->path.filename() == ".." && std::filesystem::exists(curr_dir_.parent_path())) {
     // Change to parent folder
     new_dir = curr_dir_.parent_path();
-  } else if (std::filesystem::is_directory(*active)) {
+  } else if (active->IsDirectory()) {
     // Change to selected folder
-    new_dir = curr_dir_ / active->filename();
+    new_dir = curr_dir_ / active->path.filename();
   }
 
   if (!new_dir.empty()) {
@@ -156,26 +187,29 @@ bool FileMenu::OnClickImpl() {
   }
 
   // Otherwise, it is a file, so execute custom on_click function (implemented by owner class)
-  return on_click_(*active);
+  return on_click_(active->path);
 }
 
 /* ********************************************************************************************** */
 
 void FileMenu::FilterEntriesBy(const std::string& text) {
-  // Do not even try to find it in the main list
-  if (text.empty()) {
-    filtered_entries_ = entries_;
+  if (global_search_) {
+    // Results from library index are always files, with their full path
+    library_version_ = library_->GetVersion();
+    global_entries_.clear();
+
+    for (auto& path : library_->Search(text)) {
+      auto sort_key = util::make_sort_key(path);
+      global_entries_.push_back(util::FileEntry{.path = std::move(path),
+                                                .sort_key = std::move(sort_key),
+                                                .type = std::filesystem::file_type::regular});
+    }
+
     return;
   }
 
-  filtered_entries_->clear();
-
-  // Filter entries
-  for (const auto& entry : entries_) {
-    if (util::contains(entry.filename().string(), text)) {
-      filtered_entries_->push_back(entry);
-    }
-  }
+  // Keep only indexes (sorted by best match), instead of copying every entry matching text
+  filtered_entries_ = search_index_.Filter(text);
 }
 
 /* ********************************************************************************************** */
@@ -204,11 +238,46 @@ std::filesystem::path FileMenu::ComposeDirectoryPath(const std::string& optional
 
 /* ********************************************************************************************** */
 
+void FileMenu::EnableGlobalSearch() {
+  // Index is only created when needed, as it scans every directory under library root
+  if (!library_) {
+    LOG("Create library index for global search, root=", std::quoted(library_root_.c_str()));
+    library_ = std::make_unique<util::LibraryIndex>(
+        library_root_, file_handler_->GetLibraryIndexPath(), force_refresh_);
+  } else {
+    // Look only for directories modified since last time
+    library_->Update();
+  }
+
+  global_search_ = true;
+  EnableSearch();
+}
+
+/* ********************************************************************************************** */
+
+std::string FileMenu::GetEntryText(const util::FileEntry& entry) const {
+  return global_search_ ? entry.path.lexically_relative(library_root_).string()
+                        : entry.path.filename().string();
+}
+
+/* ********************************************************************************************** */
+
 bool FileMenu::RefreshList(const std::filesystem::path& dir_path) {
+  relisted_active_.reset();
+  return StartListing(dir_path, kListingTimeout);
+}
+
+/* ********************************************************************************************** */
+
+bool FileMenu::StartListing(const std::filesystem::path& dir_path,
+                            std::chrono::milliseconds timeout) {
   LOG("Refresh list with files from new directory=", std::quoted(dir_path.c_str()));
-  util::Files tmp;
 
-  if (!file_handler_->ListFiles(dir_path, tmp)) {
+  // Start watching before listing, so no change is missed between them
+  auto watcher = file_handler_->WatchDirectory(dir_path, force_refresh_);
+  auto listing = file_handler_->ListFilesAsync(dir_path, force_refresh_);
+
+  if (!listing) {
     auto dispatcher = GetDispatcher();
     if (!dispatcher) return false;
 
@@ -217,17 +286,144 @@ bool FileMenu::RefreshList(const std::filesystem::path& dir_path) {
     return false;
   }
 
-  LOG("Updating list with new entries, size=", tmp.size());
-
-  // Reset internal values
+  // Reset internal values (and cancel listing from previous directory, if still running)
   curr_dir_ = dir_path;
+  listing_ = std::move(listing);
+  watcher_ = std::move(watcher);
+
+  // Add option to go back one level
+  util::Files tmp{util::FileEntry{.path = "..",
+                                  .sort_key = util::make_sort_key(".."),
+                                  .type = std::filesystem::file_type::directory}};
   SetEntries(tmp);  // Use this, because of the internal::Menu::Clamp logic
 
+  // Most directories are listed right away, so only keep listing in background for slow ones
+  if (!listing_->WaitFor(timeout)) {
+    LOG("Directory is taking too long to list, keep listing it in background");
+  }
+
+  ConsumeListing();
+
   return true;
 }
 
 /* ********************************************************************************************** */
 
+void FileMenu::ApplyPendingChanges() {
+  // Add any entry listed in background (and any change in directory after it)
+  ConsumeListing();
+  ConsumeChanges();
+
+  // Library index may have been updated in background, so search for text again
+  if (global_search_ && library_->GetVersion() != library_version_) {
+    FilterEntriesBy(GetSearch()->text_to_search);
+    Clamp();
+  }
+}
+
+/* ********************************************************************************************** */
+
+void FileMenu::ConsumeListing() {
+  if (!listing_) return;
+
+  util::Files listed;
+  bool finished = listing_->Consume(listed);
+
+  if (finished) {
+    LOG("Finished listing directory with size=", entries_.size() + listed.size());
+    listing_.reset();
+  }
+
+  if (!listed.empty()) {
+    // As new entries may be sorted before the active one, keep track of it
+    std::optional<util::File> active = GetActiveEntryImpl();
+    int previous = *GetSelected();
+
+    // Unless directory is being listed again and user did not move from first entry meanwhile
+    if (relisted_active_ && previous == 0) active = relisted_active_;
+
+    MergeEntries(listed);
+    UpdateSearchIndex();
+    RestoreActiveEntry(active, previous);
+  }
+
+  // Stop looking for it as soon as it is selected again (or it will never be)
+  if (finished || *GetSelected() != 0) relisted_active_.reset();
+}
+
+/* ********************************************************************************************** */
+
+void FileMenu::ConsumeChanges() {
+  // Entries changed while listing are only applied after it, otherwise they could be listed twice
+  if (!watcher_ || listing_) return;
+
+  util::Files added;
+  std::vector<util::File> removed;
+
+  if (watcher_->Consume(added, removed)) {
+    // Do not wait for it, as its entries are added by the next updates anyway
+    LOG("Lost track of changes in directory, list it again");
+
+    // Listing resets the whole list, so select the active entry again once it is listed
+    relisted_active_ = GetActiveEntryImpl();
+    if (!StartListing(curr_dir_, std::chrono::milliseconds{0})) relisted_active_.reset();
+    return;
+  }
+
+  if (added.empty() && removed.empty()) return;
+
+  LOG("Apply changes from directory, added=", added.size(), " removed=", removed.size());
+
+  // As entries may be added or removed before the active one, keep track of it
+  std::optional<util::File> active = GetActiveEntryImpl();
+  int previous = *GetSelected();
+
+  // Entries modified are reported as both removed and added, so remove every entry first
+  std::unordered_set<std::string> paths;
+  for (const auto& path : removed) paths.insert(path.string());
+
+  auto is_removed = [&paths](const util::FileEntry& e) { return paths.count(e.path.string()) > 0; };
+  entries_.erase(std::remove_if(entries_.begin() + 1, entries_.end(), is_removed), entries_.end());
+
+  std::sort(added.begin(), added.end(), util::sort_files);
+  MergeEntries(added);
+
+  UpdateSearchIndex();
+  RestoreActiveEntry(active, previous);
+}
+
+/* ********************************************************************************************** */
+
+void FileMenu::MergeEntries(util::Files& sorted) {
+  // Always keep option to go back at first
+  auto middle = entries_.insert(entries_.end(), std::make_move_iterator(sorted.begin()),
+                                std::make_move_iterator(sorted.end()));
+  std::inplace_merge(entries_.begin() + 1, middle, entries_.end(), util::sort_files);
+}
+
+/* ********************************************************************************************** */
+
+void FileMenu::RestoreActiveEntry(const std::optional<util::File>& active, int previous) {
+  if (active) {
+    int size = GetSizeImpl();
+    int index = 0;
+
+    // On search mode, list is sorted by score, so active entry may be anywhere
+    while (index < size && GetEntryAt(index).path != *active) ++index;
+
+    // Move both indexes by the amount of entries added (or removed) before the active one
+    if (index < size) {
+      int offset = index - previous;
+      *GetSelected() += offset;
+      *GetFocused() += offset;
+    }
+  }
+
+  Clamp();
+}
+
+/* ********************************************************************************************** */
+
 std::string FileMenu::GetTitle() const {
 #ifdef ENABLE_TESTS
   // It means it is running tests, so we always show only the directory name
@@ -258,20 +454,36 @@ std::string FileMenu::GetTitle() const {
 void FileMenu::SetEntriesImpl(const util::Files& entries) {
   LOG("Set a new list of entries with size=", entries.size());
   entries_ = entries;
+  UpdateSearchIndex();
+}
+
+/* ********************************************************************************************** */
+
+util::Files FileMenu::GetEntriesImpl() const {
+  if (global_search_) return global_entries_;
+  if (!IsSearchEnabled()) return entries_;
+
+  util::Files filtered;
+  filtered.reserve(filtered_entries_->size());
+
+  for (int index : *filtered_entries_) filtered.push_back(entries_[index]);
+
+  return filtered;
 }
 
 /* ********************************************************************************************** */
 
 void FileMenu::SetEntryHighlightedImpl(const util::File& entry) {
   // Find entry in internal list
-  auto it = std::find(entries_.begin(), entries_.end(), entry);
+  auto it = std::find_if(entries_.begin(), entries_.end(),
+                         [&entry](const util::FileEntry& f) { return f.path == entry; });
 
   if (it == entries_.end()) {
     LOG("Could not find entry to highlight");
     return;
   }
 
-  highlighted_ = *it;
+  highlighted_ = it->path;
 
   // To get a better experience, update focused and select indexes,
   // to highlight current playing song entry in list
@@ -283,22 +495,43 @@ void FileMenu::SetEntryHighlightedImpl(const util::File& entry) {
 /* ********************************************************************************************** */
 
 std::optional<util::File> FileMenu::GetActiveEntryImpl() const {
+  const util::FileEntry* active = GetActiveFileEntry();
+  return active ? std::optional<util::File>{active->path} : std::nullopt;
+}
+
+/* ********************************************************************************************** */
+
+const util::FileEntry* FileMenu::GetActiveFileEntry() const {
   int size = GetSizeImpl();
 
   // Empty list
-  if (!size) return std::nullopt;
+  if (!size) return nullptr;
 
-  // Get active entry
-  std::optional<util::File> entry = std::nullopt;
   int index = GetSelected();
 
   // Check for boundary and if vector not empty
-  if (index >= size || entries_.empty() ||
+  if (index >= size || (!global_search_ && entries_.empty()) ||
       (filtered_entries_.has_value() && filtered_entries_->empty()))
-    return entry;
+    return nullptr;
+
+  return &GetEntryAt(index);
+}
+
+/* ********************************************************************************************** */
+
+const util::FileEntry& FileMenu::GetEntryAt(int index) const {
+  if (global_search_) return global_entries_.at(index);
+
+  return IsSearchEnabled() ? entries_.at(filtered_entries_->at(index)) : entries_.at(index);
+}
+
+/* ********************************************************************************************** */
+
+void FileMenu::UpdateSearchIndex() {
+  search_index_.Clear();
+  for (const auto& entry : entries_) search_index_.Add(entry.path.filename().string());
 
-  entry = IsSearchEnabled() ? filtered_entries_->at(index) : entries_.at(index);
-  return entry;
+  if (IsSearchEnabled()) FilterEntriesBy(GetSearch()->text_to_search);
 }
 
 }  // namespace internal
@@ -1,5 +1,9 @@
 #include "view/element/internal/playlist_menu.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "ftxui/component/component.hpp"
 #include "ftxui/dom/elements.hpp"
 #include "model/playlist.h"
@@ -16,45 +20,66 @@ PlaylistMenu::PlaylistMenu(const std::shared_ptr<EventDispatcher>& dispatcher,
 /* ********************************************************************************************** */
 
 ftxui::Element PlaylistMenu::RenderImpl() {
+  ftxui::Elements content{
+      RenderEntries() | ftxui::flex,
+  };
+
+  // Append search box, if enabled
+  if (IsSearchEnabled()) {
+    content.push_back(RenderSearch());
+    content.push_back(ftxui::text(""));
+  }
+
+  return ftxui::vbox(content) | ftxui::flex;
+}
+
+/* ********************************************************************************************** */
+
+ftxui::Elements PlaylistMenu::RenderEntriesImpl(int first, int last) {
   ftxui::Elements menu_entries;
-  menu_entries.reserve(GetSize() + 1);  // Entries size + filler element
+  menu_entries.reserve(last - first);
 
-  InternalPlaylists const* tmp = IsSearchEnabled() ? std::addressof(*filtered_entries_) : &entries_;
+  int size = GetPlaylistsSize();
   int index = 0;
 
-  // Fill list with entries
-  for (const auto& entry : *tmp) {
+  // Fill list only with entries visible on screen
+  for (int position = 0; position < size; ++position) {
+    if (index >= last) break;
+
+    int songs = GetVisibleSongsSize(position);
+
+    // Skip whole playlist if none of its entries is visible
+    if (index + songs < first) {
+      index += 1 + songs;
+      continue;
+    }
+
+    const auto& entry = GetPlaylistAt(position);
     bool is_highlighted = highlighted_ ? highlighted_->playlist == entry.playlist.name : false;
 
     // Add playlist
-    menu_entries.push_back(CreateEntry(index++, entry.playlist.name, is_highlighted, true,
-                                       " [" + std::to_string(entry.playlist.songs.size()) + "]"));
+    if (index >= first) {
+      menu_entries.push_back(CreateEntry(index, entry.playlist.name, is_highlighted, true,
+                                         " [" + std::to_string(GetSongsSize(position)) + "]"));
+    }
 
-    if (!entry.collapsed) continue;
+    ++index;
 
     // Add songs
-    for (const auto& song : entry.playlist.songs) {
+    for (int i = std::max(0, first - index); i < songs && index + i < last; ++i) {
+      const auto& song = entry.playlist.songs[GetSongIndexAt(position, i)];
+
       is_highlighted = highlighted_ ? highlighted_->playlist == entry.playlist.name &&
                                           highlighted_->filepath == song.filepath
                                     : false;
       menu_entries.push_back(
-          CreateEntry(index++, song.filepath.filename().string(), is_highlighted, false));
+          CreateEntry(index + i, song.filepath.filename().string(), is_highlighted, false));
     }
-  }
 
-  menu_entries.push_back(ftxui::filler());
-
-  ftxui::Elements content{
-      ftxui::vbox(menu_entries) | ftxui::reflect(Box()) | ftxui::frame | ftxui::flex,
-  };
-
-  // Append search box, if enabled
-  if (IsSearchEnabled()) {
-    content.push_back(RenderSearch());
-    content.push_back(ftxui::text(""));
+    index += songs;
   }
 
-  return ftxui::vbox(content) | ftxui::flex;
+  return menu_entries;
 }
 
 /* ********************************************************************************************** */
@@ -90,13 +115,11 @@ bool PlaylistMenu::OnEventImpl(const ftxui::Event& event) {
 
 int PlaylistMenu::GetSizeImpl() const {
   int size = 0;
+  int playlists = GetPlaylistsSize();
 
-  const InternalPlaylists* const tmp =
-      IsSearchEnabled() ? std::addressof(*filtered_entries_) : &entries_;
-
-  for (const auto& entry : *tmp) {
+  for (int position = 0; position < playlists; ++position) {
     // playlist name + songs size
-    size += 1 + (entry.collapsed ? entry.playlist.songs.size() : 0);
+    size += 1 + GetVisibleSongsSize(position);
   }
 
   return size;
@@ -107,25 +130,24 @@ int PlaylistMenu::GetSizeImpl() const {
 std::string PlaylistMenu::GetActiveEntryAsTextImpl() const {
   int count = 0;
   int selected = GetSelected();
+  int size = GetPlaylistsSize();
 
-  const InternalPlaylists* const tmp =
-      IsSearchEnabled() ? std::addressof(*filtered_entries_) : &entries_;
-
-  for (const auto& entry : *tmp) {
+  for (int position = 0; position < size; ++position) {
+    const auto& entry = GetPlaylistAt(position);
     if (count == selected) return entry.playlist.name;
 
     // Already checked playlist index, so increment count
     ++count;
 
-    // Just skip if playlist is not collapsed
-    if (!entry.collapsed) continue;
-
-    for (const auto& song : entry.playlist.songs) {
-      if (count == selected) return song.filepath.filename().string();
+    // Selected index may be pointing to a song entry from this playlist
+    int songs = GetVisibleSongsSize(position);
 
-      // Already checked song index, so increment count
-      ++count;
+    if (selected < count + songs) {
+      const auto& song = entry.playlist.songs[GetSongIndexAt(position, selected - count)];
+      return song.filepath.filename().string();
     }
+
+    count += songs;
   }
 
   ERROR("Could not find an active entry");
@@ -145,34 +167,38 @@ bool PlaylistMenu::OnClickImpl() {
 /* ********************************************************************************************** */
 
 void PlaylistMenu::FilterEntriesBy(const std::string& text) {
-  // Do not even try to filter
+  filtered_entries_.emplace();
+
+  // Do not even try to filter (but keep indexes for all entries)
   if (text.empty()) {
-    filtered_entries_ = entries_;
+    filtered_entries_->reserve(entries_.size());
+
+    for (int playlist = 0; playlist < static_cast<int>(entries_.size()); ++playlist) {
+      const auto& entry = entries_[playlist];
+      std::vector<int> songs(entry.playlist.songs.size());
+      std::iota(songs.begin(), songs.end(), 0);
+
+      filtered_entries_->push_back(FilteredPlaylist{
+          .index = playlist, .collapsed = entry.collapsed, .songs = std::move(songs)});
+    }
+
     return;
   }
 
-  filtered_entries_->clear();
-
-  // Filter entries (try to match any of these: playlist title or song filepath)
-  for (const auto& entry : entries_) {
-    bool contains_text = util::contains(entry.playlist.name, text);
+  // Position of each playlist in filtered list (if any of its entries is matching text)
+  std::vector<int> positions(entries_.size(), -1);
 
-    // Create temporary playlist
-    InternalPlaylist tmp{
-        .collapsed = true,
-        .playlist = model::Playlist{.index = entry.playlist.index, .name = entry.playlist.name},
-    };
+  // Filter entries (try to match any of these: playlist title or song filepath), so playlists are
+  // sorted by their best match, and only songs matching text are kept (also sorted by match)
+  for (int match : search_index_.Filter(text)) {
+    auto [playlist, song] = search_entries_[match];
 
-    // Append only filtered songs
-    for (const auto& song : entry.playlist.songs) {
-      if (util::contains(song.filepath.filename().string(), text)) {
-        tmp.playlist.songs.push_back(song);
-        contains_text = true;
-      }
+    if (positions[playlist] == -1) {
+      positions[playlist] = static_cast<int>(filtered_entries_->size());
+      filtered_entries_->push_back(FilteredPlaylist{.index = playlist, .collapsed = true});
     }
 
-    // Only add if playlist name or song (artist/title) contains the given text
-    if (contains_text) filtered_entries_->push_back(tmp);
+    if (song != kPlaylistName) filtered_entries_->at(positions[playlist]).songs.push_back(song);
   }
 }
 
@@ -197,26 +223,100 @@ void PlaylistMenu::SetEntriesImpl(const model::Playlists& entries) {
     };
     entries_.push_back(tmp);
   }
+
+  UpdateSearchIndex();
+}
+
+/* ********************************************************************************************** */
+
+PlaylistMenu::InternalPlaylists PlaylistMenu::GetEntriesImpl() const {
+  if (!IsSearchEnabled()) return entries_;
+
+  InternalPlaylists filtered;
+  filtered.reserve(filtered_entries_->size());
+
+  for (const auto& entry : *filtered_entries_) {
+    const auto& playlist = entries_[entry.index].playlist;
+    auto& tmp = filtered.emplace_back(InternalPlaylist{
+        .collapsed = entry.collapsed,
+        .playlist = model::Playlist{.index = playlist.index, .name = playlist.name},
+    });
+
+    for (int song : entry.songs) tmp.playlist.songs.push_back(playlist.songs[song]);
+  }
+
+  return filtered;
+}
+
+/* ********************************************************************************************** */
+
+int PlaylistMenu::GetPlaylistsSize() const {
+  return static_cast<int>(IsSearchEnabled() ? filtered_entries_->size() : entries_.size());
+}
+
+/* ********************************************************************************************** */
+
+const PlaylistMenu::InternalPlaylist& PlaylistMenu::GetPlaylistAt(int position) const {
+  return IsSearchEnabled() ? entries_.at(filtered_entries_->at(position).index)
+                           : entries_.at(position);
+}
+
+/* ********************************************************************************************** */
+
+int PlaylistMenu::GetSongsSize(int position) const {
+  return static_cast<int>(IsSearchEnabled() ? filtered_entries_->at(position).songs.size()
+                                            : entries_.at(position).playlist.songs.size());
+}
+
+/* ********************************************************************************************** */
+
+int PlaylistMenu::GetVisibleSongsSize(int position) const {
+  bool collapsed = IsSearchEnabled() ? filtered_entries_->at(position).collapsed
+                                     : entries_.at(position).collapsed;
+
+  return collapsed ? GetSongsSize(position) : 0;
+}
+
+/* ********************************************************************************************** */
+
+int PlaylistMenu::GetSongIndexAt(int position, int song) const {
+  return IsSearchEnabled() ? filtered_entries_->at(position).songs.at(song) : song;
+}
+
+/* ********************************************************************************************** */
+
+void PlaylistMenu::UpdateSearchIndex() {
+  search_index_.Clear();
+  search_entries_.clear();
+
+  for (int playlist = 0; playlist < static_cast<int>(entries_.size()); ++playlist) {
+    const auto& songs = entries_[playlist].playlist.songs;
+
+    search_index_.Add(entries_[playlist].playlist.name);
+    search_entries_.emplace_back(playlist, kPlaylistName);
+
+    for (int song = 0; song < static_cast<int>(songs.size()); ++song) {
+      search_index_.Add(songs[song].filepath.filename().string());
+      search_entries_.emplace_back(playlist, song);
+    }
+  }
+
+  if (IsSearchEnabled()) FilterEntriesBy(GetSearch()->text_to_search);
 }
 
 /* ********************************************************************************************** */
 
 void PlaylistMenu::SetEntryHighlightedImpl(const model::Song& entry) {
   int index = 0;
-  int count = 0;
   bool found = false;
 
   for (auto& tmp : entries_) {
     // Count playlist name
     if (!found) ++index;
-    ++count;
 
     if (tmp.playlist.name != entry.playlist) {
       // Count all songs from this playlist
-      if (tmp.collapsed) {
-        index += !found ? tmp.playlist.songs.size() : 0;
-        count += tmp.playlist.songs.size();
-      }
+      if (tmp.collapsed && !found) index += tmp.playlist.songs.size();
 
       continue;
     }
@@ -234,7 +334,6 @@ void PlaylistMenu::SetEntryHighlightedImpl(const model::Song& entry) {
 
       // Only increment if did not find song yet
       if (!found) ++index;
-      ++count;
     }
   }
 
@@ -243,10 +342,6 @@ void PlaylistMenu::SetEntryHighlightedImpl(const model::Song& entry) {
     return;
   }
 
-  // Resize boxes vector
-  auto& boxes = GetBoxes();
-  boxes.resize(count);
-
   // To get a better experience, update focused and select indexes,
   // to highlight current playing song entry in playlist
   ResetState(index);
@@ -257,26 +352,12 @@ void PlaylistMenu::SetEntryHighlightedImpl(const model::Song& entry) {
 std::optional<model::Playlist> PlaylistMenu::GetActiveEntryImpl() const {
   int count = 0;
   int selected = GetSelected();
+  int size = GetPlaylistsSize();
 
-  const InternalPlaylists* const tmp =
-      IsSearchEnabled() ? std::addressof(*filtered_entries_) : &entries_;
-
-  for (const auto& entry : *tmp) {
-    // Selected index is the playlist itself, so just return
-    if (count == selected) return entry.playlist;
-
-    // Already checked playlist index, so increment count
-    ++count;
-
-    if (!entry.collapsed) continue;
-
-    // Otherwise, selected index may be pointing to a song entry
-    for (auto it = entry.playlist.songs.begin(); it != entry.playlist.songs.end(); ++it, ++count) {
-      if (count == selected) {
-        // Get full playlist
-        return entry.playlist;
-      }
-    }
+  for (int position = 0; position < size; ++position) {
+    // Selected index is the playlist itself or one of its songs, so return the full playlist
+    count += 1 + GetVisibleSongsSize(position);
+    if (selected < count) return GetPlaylistAt(position).playlist;
   }
 
   return std::nullopt;
@@ -291,8 +372,6 @@ ftxui::Element PlaylistMenu::CreateEntry(int index, const std::string& text, boo
 
   auto max_size = GetMaxColumns() ? ftxui::size(WIDTH, EQUAL, GetMaxColumns()) : ftxui::nothing;
 
-  auto& boxes = GetBoxes();
-
   bool is_focused = (index == *GetFocused());
   bool is_selected = (index == *GetSelected());
 
@@ -306,8 +385,6 @@ ftxui::Element PlaylistMenu::CreateEntry(int index, const std::string& text, boo
   ftxui::Decorator style = is_selected ? (is_focused ? type.selected_focused : type.selected)
                                        : (is_focused ? type.focused : type.normal);
 
-  auto focus_management = is_focused ? ftxui::select : ftxui::nothing;
-
   // In case of entry text too long, animation thread will be running, so we gotta take the
   // text content from there
   auto entry_text =
@@ -318,7 +395,7 @@ ftxui::Element PlaylistMenu::CreateEntry(int index, const std::string& text, boo
              ftxui::text(!is_playlist ? "  " : "") | style,
              entry_text | style | ftxui::xflex,
          }) |
-         max_size | focus_management | ftxui::reflect(boxes[index]);
+         max_size;
 }
 
 /* ********************************************************************************************** */
@@ -356,7 +433,7 @@ bool PlaylistMenu::ToggleActivePlaylist(const CollapseState& state) {
     LOG(internal_playlist->collapsed ? "Show" : "Hide",
         " collapsed playlist=", std::quoted(internal_playlist->playlist.name));
 
-    // Resize vector of boxes to new size and check if must enable text animation
+    // Clamp indexes to new size and check if must enable text animation
     Clamp();
     UpdateActiveEntry();
   }
@@ -397,20 +474,15 @@ std::optional<model::Playlist> PlaylistMenu::GetActivePlaylistFromSearch() const
   // Do not even try
   if (!IsSearchEnabled()) return std::nullopt;
 
-  // Playlist values from search
-  int playlist_index = -1;
-  std::filesystem::path song;
-
   int count = 0;
   int selected = GetSelected();
 
-  // Find original playlist index to query later in original list
+  // Resolve selected index into its original playlist (and song, if selected)
   for (const auto& entry : *filtered_entries_) {
+    const auto& playlist = entries_[entry.index].playlist;
+
     // Selected index is the playlist itself, so just return
-    if (count == selected) {
-      playlist_index = entry.playlist.index;
-      break;
-    }
+    if (count == selected) return playlist;
 
     // Already checked playlist index, so increment count
     ++count;
@@ -418,33 +490,13 @@ std::optional<model::Playlist> PlaylistMenu::GetActivePlaylistFromSearch() const
     if (!entry.collapsed) continue;
 
     // Otherwise, selected index may be pointing to a song entry
-    for (auto it = entry.playlist.songs.begin(); it != entry.playlist.songs.end(); ++it, ++count) {
-      // Selected index is a song from this playlist
-      if (count == selected) {
-        playlist_index = entry.playlist.index;
-        song = it->filepath;
-        break;
-      }
-    }
+    int songs = static_cast<int>(entry.songs.size());
 
-    // Just get out
-    if (playlist_index != -1) break;
-  }
-
-  // With these values, find playlist in the original list of entries
-  for (const auto& entry : entries_) {
-    if (playlist_index != -1 && playlist_index == entry.playlist.index && song.empty()) {
-      return entry.playlist;
+    if (selected < count + songs) {
+      return ShufflePlaylist(playlist, playlist.songs.begin() + entry.songs[selected - count]);
     }
 
-    if (playlist_index > entry.playlist.index) continue;
-
-    // Otherwise, selected index may be pointing to a song entry
-    for (auto it = entry.playlist.songs.begin(); it != entry.playlist.songs.end(); ++it) {
-      if (playlist_index != -1 && playlist_index == entry.playlist.index && it->filepath == song) {
-        return ShufflePlaylist(entry.playlist, it);
-      }
-    }
+    count += songs;
   }
 
   return std::nullopt;
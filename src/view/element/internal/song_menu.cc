@@ -10,23 +10,35 @@ SongMenu::SongMenu(const std::shared_ptr<EventDispatcher>& dispatcher,
 /* ********************************************************************************************** */
 
 ftxui::Element SongMenu::RenderImpl() {
+  ftxui::Elements content{
+      RenderEntries() | ftxui::flex,
+  };
+
+  // Append search box, if enabled
+  if (IsSearchEnabled()) {
+    content.push_back(RenderSearch());
+  }
+
+  return ftxui::vbox(content) | ftxui::flex;
+}
+
+/* ********************************************************************************************** */
+
+ftxui::Elements SongMenu::RenderEntriesImpl(int first, int last) {
   using ftxui::EQUAL;
   using ftxui::WIDTH;
 
   auto max_size = GetMaxColumns() ? ftxui::size(WIDTH, EQUAL, GetMaxColumns()) : ftxui::nothing;
 
   ftxui::Elements menu_entries;
-
-  int size = GetSize();
-  menu_entries.reserve(size);
+  menu_entries.reserve(last - first);
 
   const auto selected = GetSelected();
   const auto focused = GetFocused();
-  auto& boxes = GetBoxes();
 
-  // Fill list with entries
-  for (int i = 0; i < size; ++i) {
-    const auto& entry = IsSearchEnabled() ? filtered_entries_->at(i) : entries_.at(i);
+  // Fill list only with entries visible on screen
+  for (int i = first; i < last; ++i) {
+    const auto& entry = GetEntryAt(i);
 
     bool is_focused = (*focused == i);
     bool is_selected = (*selected == i);
@@ -38,8 +50,6 @@ ftxui::Element SongMenu::RenderImpl() {
     ftxui::Decorator style = is_selected ? (is_focused ? type.selected_focused : type.selected)
                                          : (is_focused ? type.focused : type.normal);
 
-    auto focus_management = is_focused ? ftxui::select : ftxui::nothing;
-
     // In case of entry text too long, animation thread will be running, so we gotta take the
     // text content from there
     auto text =
@@ -50,19 +60,10 @@ ftxui::Element SongMenu::RenderImpl() {
                                prefix | style_.prefix,
                                text | style | ftxui::xflex,
                            }) |
-                           max_size | focus_management | ftxui::reflect(boxes[i]));
+                           max_size);
   }
 
-  ftxui::Elements content{
-      ftxui::vbox(menu_entries) | ftxui::reflect(Box()) | ftxui::frame | ftxui::flex,
-  };
-
-  // Append search box, if enabled
-  if (IsSearchEnabled()) {
-    content.push_back(RenderSearch());
-  }
-
-  return ftxui::vbox(content) | ftxui::flex;
+  return menu_entries;
 }
 
 /* ********************************************************************************************** */
@@ -105,20 +106,8 @@ bool SongMenu::OnClickImpl() {
 /* ********************************************************************************************** */
 
 void SongMenu::FilterEntriesBy(const std::string& text) {
-  // Do not even try to find it in the main list
-  if (text.empty()) {
-    filtered_entries_ = entries_;
-    return;
-  }
-
-  filtered_entries_->clear();
-
-  // Filter entries
-  for (const auto& entry : entries_) {
-    if (util::contains(entry.filepath.filename().string(), text)) {
-      filtered_entries_->push_back(entry);
-    }
-  }
+  // Keep only indexes (sorted by best match), instead of copying every entry matching text
+  filtered_entries_ = search_index_.Filter(text);
 }
 
 /* ********************************************************************************************** */
@@ -126,6 +115,18 @@ void SongMenu::FilterEntriesBy(const std::string& text) {
 void SongMenu::SetEntriesImpl(const std::deque<model::Song>& entries) {
   LOG("Set a new list of entries with size=", entries.size());
   entries_ = entries;
+  UpdateSearchIndex();
+}
+
+/* ********************************************************************************************** */
+
+std::deque<model::Song> SongMenu::GetEntriesImpl() const {
+  if (!IsSearchEnabled()) return entries_;
+
+  std::deque<model::Song> filtered;
+  for (int index : *filtered_entries_) filtered.push_back(entries_[index]);
+
+  return filtered;
 }
 
 /* ********************************************************************************************** */
@@ -145,9 +146,24 @@ std::optional<model::Song> SongMenu::GetActiveEntryImpl() const {
       (filtered_entries_.has_value() && filtered_entries_->empty()))
     return entry;
 
-  entry = IsSearchEnabled() ? filtered_entries_->at(index) : entries_.at(index);
+  entry = GetEntryAt(index);
   return entry;
 }
 
+/* ********************************************************************************************** */
+
+const model::Song& SongMenu::GetEntryAt(int index) const {
+  return IsSearchEnabled() ? entries_.at(filtered_entries_->at(index)) : entries_.at(index);
+}
+
+/* ********************************************************************************************** */
+
+void SongMenu::UpdateSearchIndex() {
+  search_index_.Clear();
+  for (const auto& entry : entries_) search_index_.Add(entry.filepath.filename().string());
+
+  if (IsSearchEnabled()) FilterEntriesBy(GetSearch()->text_to_search);
+}
+
 }  // namespace internal
 }  // namespace interface
@@ -0,0 +1,87 @@
+#include "view/element/internal/virtual_list.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/dom/requirement.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace interface::internal {
+
+namespace {
+
+/**
+ * @brief Node to create and draw only the entries visible on screen
+ */
+class VirtualListNode : public ftxui::Node {
+ public:
+  VirtualListNode(int size, int focused, int width, EntriesRenderer render, Viewport& viewport)
+      : size_{size},
+        focused_{focused},
+        width_{width},
+        render_{std::move(render)},
+        viewport_{viewport} {}
+
+  void ComputeRequirement() override {
+    // Report the same requirement as a vbox containing all entries
+    requirement_.min_x = width_;
+    requirement_.min_y = size_;
+
+    // And as focused entry was selected, so any parent frame keeps it visible too
+    if (focused_ >= 0 && focused_ < size_) {
+      requirement_.selection = ftxui::Requirement::SELECTED;
+      requirement_.selected_box = ftxui::Box{0, std::max(0, width_ - 1), focused_, focused_};
+    }
+  }
+
+  void Render(ftxui::Screen& screen) override {
+    // Scroll list to keep focused entry centered (while not scrolling past its ends)
+    const int height = box_.y_max - box_.y_min + 1;
+    const int offset = std::max(0, std::min(size_ - height, focused_ - (height - 1) / 2));
+
+    // Only entries within visible area are created
+    const ftxui::Box area = ftxui::Box::Intersection(box_, screen.stencil);
+    const int first = offset + std::max(0, area.y_min - box_.y_min);
+    const int last = std::min(size_, offset + area.y_max - box_.y_min + 1);
+
+    viewport_.box = area;
+    viewport_.first = first;
+
+    if (first >= last) return;
+
+    // Do not let entries draw anything outside of the visible area
+    const ftxui::Box stencil = screen.stencil;
+    screen.stencil = area;
+
+    int y = box_.y_min + (first - offset);
+
+    for (auto& entry : render_(first, last)) {
+      entry->ComputeRequirement();
+      entry->SetBox(ftxui::Box{box_.x_min, box_.x_max, y, y});
+      entry->Render(screen);
+      y++;
+    }
+
+    screen.stencil = stencil;
+  }
+
+ private:
+  int size_;                //!< Total number of entries
+  int focused_;             //!< Index for focused entry
+  int width_;               //!< Minimum width for entries
+  EntriesRenderer render_;  //!< Create elements for entries
+  Viewport& viewport_;      //!< Visible area from last render
+};
+
+}  // namespace
+
+/* ********************************************************************************************** */
+
+ftxui::Element VirtualList(int size, int focused, int width, EntriesRenderer render,
+                           Viewport& viewport) {
+  return std::make_shared<VirtualListNode>(size, focused, width, std::move(render), viewport);
+}
+
+}  // namespace interface::internal
@@ -0,0 +1,160 @@
+#include "view/element/spectrum.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "ftxui/dom/node.hpp"
+#include "ftxui/dom/requirement.hpp"
+#include "ftxui/screen/box.hpp"
+#include "ftxui/screen/color.hpp"
+#include "ftxui/screen/screen.hpp"
+
+namespace interface {
+
+namespace {
+
+//! Glyphs for the top cell of a bar, indexed by how many eighths of the cell are left empty
+constexpr std::array<const char*, 8> kBarGlyphs{"█", "▇", "▆", "▅", "▄", "▃", "▂", "▁"};
+
+constexpr const char* kFullGlyph = "█";   //!< Glyph for cells completely filled by a bar
+constexpr const char* kEmptyGlyph = " ";  //!< Glyph for cells not filled by a bar
+
+/**
+ * @brief Get bar colour at the given position, using a linear gradient from bar base to its top
+ * @param position Relative position (from 0 to 1), where 0 is the bar base
+ * @return Bar colour
+ */
+ftxui::Color GetGradientColor(float position) {
+  const std::array<float, 5> stops{0.0f, 0.3f, 0.6f, 0.8f, 1.0f};
+  const std::array<ftxui::Color, 5> colors{
+      ftxui::Color(95, 135, 215),  ftxui::Color(115, 155, 215), ftxui::Color(155, 188, 235),
+      ftxui::Color(185, 208, 252), ftxui::Color(185, 208, 252),
+  };
+
+  size_t i = 1;
+  while (i < stops.size() - 1 && position > stops[i]) i++;
+
+  float value = (position - stops[i - 1]) / (stops[i] - stops[i - 1]);
+  return ftxui::Color::Interpolate(std::clamp(value, 0.0f, 1.0f), colors[i - 1], colors[i]);
+}
+
+/* ********************************************************************************************** */
+
+/**
+ * @brief Node to draw all audio bars in a single render pass
+ */
+class SpectrumNode : public ftxui::Node {
+ public:
+  SpectrumNode(std::vector<SpectrumBars> rows, int bar_width, int spacing)
+      : rows_{std::move(rows)}, bar_width_{bar_width}, spacing_{spacing} {}
+
+  void ComputeRequirement() override {
+    int width = 0;
+    for (const auto& row : rows_) width = std::max(width, GetRowWidth(row));
+
+    requirement_.min_x = width;
+    requirement_.min_y = static_cast<int>(rows_.size());
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+  }
+
+  void Render(ftxui::Screen& screen) override {
+    if (rows_.empty()) return;
+
+    // Split height between rows, the same way as a vbox with flexible children would do
+    int total = static_cast<int>(rows_.size());
+    int extra = std::max(0, box_.y_max - box_.y_min + 1 - total);
+    int y_min = box_.y_min;
+
+    for (const auto& row : rows_) {
+      int height = 1 + extra / total;
+      extra -= height - 1;
+      total--;
+
+      RenderRow(screen, row, y_min, height);
+      y_min += height;
+    }
+  }
+
+ private:
+  //! Get total width for a row of bars
+  int GetRowWidth(const SpectrumBars& row) const {
+    auto size = static_cast<int>(row.values.size());
+    return size > 0 ? size * (bar_width_ + spacing_) - spacing_ : 0;
+  }
+
+  //! Draw a single row of bars within the given lines
+  void RenderRow(ftxui::Screen& screen, const SpectrumBars& row, int y_min, int height) {
+    if (row.values.empty() || height <= 0) return;
+
+    const int y_max = y_min + height - 1;
+    const int width = GetRowWidth(row);
+
+    // Only draw what is visible on screen
+    const ftxui::Box area = ftxui::Box::Intersection(box_, screen.stencil);
+    const int first_line = std::max(y_min, area.y_min);
+    const int last_line = std::min(y_max, area.y_max);
+
+    // Precompute colour for each line, as it only depends on the distance from bar base
+    palette_.resize(height);
+    for (int i = 0; i < height; i++) {
+      palette_[i] = GetGradientColor(height > 1 ? static_cast<float>(i) / (height - 1) : 0.0f);
+    }
+
+    // Centralize bars horizontally
+    int x = box_.x_min + std::max(0, box_.x_max - box_.x_min + 1 - width) / 2;
+
+    for (size_t index = 0; index < row.values.size(); index++) {
+      // This handles NaN as well
+      float value = static_cast<float>(row.values[index]);
+      if (!(value > 0.0f)) value = 0.0f;
+      if (!(value < 1.0f)) value = 1.0f;
+
+      // Bars drawn upside down are filled with empty glyphs and then inverted, so the top cell
+      // shows as many eighths as the ones left empty when drawing bars from bottom to top
+      const float progress = row.upside_down ? value : 1.0f - value;
+      const float limit = static_cast<float>(y_min) + progress * static_cast<float>(height);
+      const int limit_int = static_cast<int>(limit);
+      const char* partial = kBarGlyphs[static_cast<int>(8 * (limit - limit_int))];
+
+      // Bar columns followed by spacing columns (except for the last bar)
+      int columns = bar_width_ + (index + 1 < row.values.size() ? spacing_ : 0);
+
+      for (int column = 0; column < columns; column++, x++) {
+        if (x < area.x_min || x > area.x_max) continue;
+
+        for (int y = first_line; y <= last_line; y++) {
+          ftxui::Pixel& pixel = screen.PixelAt(x, y);
+
+          if (column >= bar_width_) {
+            pixel.character = kEmptyGlyph;
+            continue;
+          }
+
+          pixel.character = y < limit_int ? kEmptyGlyph : y == limit_int ? partial : kFullGlyph;
+          pixel.foreground_color = palette_[row.upside_down ? y - y_min : y_max - y];
+          if (row.upside_down) pixel.inverted ^= true;
+        }
+      }
+    }
+  }
+
+  std::vector<SpectrumBars> rows_;     //!< Rows of audio bars
+  int bar_width_;                      //!< Width for a single bar
+  int spacing_;                        //!< Spacing between bars
+  std::vector<ftxui::Color> palette_;  //!< Colour for each line, starting from bar base
+};
+
+}  // namespace
+
+/* ********************************************************************************************** */
+
+ftxui::Element Spectrum(std::vector<SpectrumBars> rows, int bar_width, int spacing) {
+  return std::make_shared<SpectrumNode>(std::move(rows), bar_width, spacing);
+}
+
+}  // namespace interface
@@ -3,30 +3,33 @@
 namespace interface {
 
 TextAnimation::~TextAnimation() {
-  // Ensure that thread will be stopped
+  // Ensure that animation will be stopped
   Stop();
 }
 
 /* ********************************************************************************************** */
 
 void TextAnimation::Start(const std::string& entry) {
-  // Append an empty space for better aesthetics
-  text = entry + " ";
-  enabled = true;
+  Stop();
 
-  thread = std::thread([this] {
-    using namespace std::chrono_literals;
-    std::unique_lock lock(mutex);
+  {
+    // Append an empty space for better aesthetics
+    std::scoped_lock lock(mutex);
+    text = entry + " ";
+    enabled = true;
+  }
 
-    // Run the animation every 0.2 seconds while enabled is true
-    while (!notifier.wait_for(lock, 0.2s, [this] { return enabled == false; })) {
+  // Run the animation every 0.2 seconds until stopped
+  id = Ticker::GetInstance().Register(kInterval, [this] {
+    {
       // Here comes the magic
+      std::scoped_lock lock(mutex);
       text += text.front();
       text.erase(text.begin());
-
-      // Notify UI
-      cb_update();
     }
+
+    // Notify UI
+    if (cb_update) cb_update();
   });
 }
 
@@ -34,23 +37,16 @@ void TextAnimation::Start(const std::string& entry) {
 
 void TextAnimation::Stop() {
   if (enabled) {
-    Notify();
-    Exit();
+    enabled = false;
+    Ticker::GetInstance().Unregister(id);
   }
 }
 
 /* ********************************************************************************************** */
 
-void TextAnimation::Notify() {
+std::string TextAnimation::GetText() const {
   std::scoped_lock lock(mutex);
-  enabled = false;
-}
-
-/* ********************************************************************************************** */
-
-void TextAnimation::Exit() {
-  notifier.notify_one();
-  thread.join();
+  return text;
 }
 
 }  // namespace interface
@@ -4,6 +4,7 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#include <atomic>
 #include <memory>
 
 #include "audio/lyric/lyric_finder.h"
@@ -18,6 +19,7 @@ using ::testing::_;
 using ::testing::DoAll;
 using ::testing::ElementsAreArray;
 using ::testing::Eq;
+using ::testing::InvokeWithoutArgs;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 using ::testing::StrEq;
@@ -59,7 +61,8 @@ class LyricFinderTest : public ::testing::Test {
   size_t GetNumberOfEngines() { return finder->engines_.size(); }
 
  protected:
-  LyricFinder finder;  //!< Song lyrics finder
+  LyricFinder finder;                 //!< Song lyrics finder
+  std::atomic<bool> cancelled{false};  //!< Flag to cancel search
 };
 
 /* ********************************************************************************************** */
@@ -70,13 +73,13 @@ TEST_F(LyricFinderTest, SearchWithEmptyResult) {
   auto number_engines = GetNumberOfEngines();
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _)).Times(number_engines);
+  EXPECT_CALL(*fetcher, Fetch(_, _, _)).Times(number_engines);
   EXPECT_CALL(*parser, Parse(_, _)).Times(number_engines);
 
   std::string artist{"Powfu"};
   std::string title{"abandoned house"};
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, Eq(lyric::SongLyric{}));
 }
 
@@ -109,7 +112,7 @@ TEST_F(LyricFinderTest, SearchWithResultUsingGoogle) {
   };
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _)).Times(1).WillOnce(Return(error::kSuccess));
+  EXPECT_CALL(*fetcher, Fetch(_, _, _)).Times(1).WillOnce(Return(error::kSuccess));
   EXPECT_CALL(*parser, Parse(_, _)).Times(1).WillOnce(Return(raw));
 
   std::string artist{"INZO"};
@@ -137,7 +140,7 @@ TEST_F(LyricFinderTest, SearchWithResultUsingGoogle) {
       "With the real world\n",
   };
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
 }
 
@@ -187,7 +190,7 @@ TEST_F(LyricFinderTest, SearchWithResultUsingAZLyrics) {
   };
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _))
+  EXPECT_CALL(*fetcher, Fetch(_, _, _))
       .Times(2)
       .WillOnce(Return(error::kUnknownError))
       .WillOnce(Return(error::kSuccess));
@@ -234,7 +237,7 @@ TEST_F(LyricFinderTest, SearchWithResultUsingAZLyrics) {
       "You ain't special, everybody got problems, uh\n",
   };
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
 }
 
@@ -245,7 +248,7 @@ TEST_F(LyricFinderTest, ErrorOnFetch) {
   auto parser = GetParser();
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _)).Times(2).WillRepeatedly(Return(error::kUnknownError));
+  EXPECT_CALL(*fetcher, Fetch(_, _, _)).Times(2).WillRepeatedly(Return(error::kUnknownError));
   EXPECT_CALL(*parser, Parse(_, _)).Times(0);
 
   std::string artist{"Funkin' Sound Team"};
@@ -253,7 +256,30 @@ TEST_F(LyricFinderTest, ErrorOnFetch) {
 
   const lyric::SongLyric expected{};
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
+  EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(LyricFinderTest, CancelWhileFetching) {
+  auto fetcher = GetFetcher();
+  auto parser = GetParser();
+
+  // Setup expectations (cancel search while fetching content from first search engine)
+  EXPECT_CALL(*fetcher, Fetch(_, _, _)).Times(1).WillOnce(InvokeWithoutArgs([this] {
+    cancelled = true;
+    return error::kUnknownError;
+  }));
+
+  EXPECT_CALL(*parser, Parse(_, _)).Times(0);
+
+  std::string artist{"Funkin' Sound Team"};
+  std::string title{"M.I.L.F"};
+
+  const lyric::SongLyric expected{};
+
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
 }
 
@@ -264,7 +290,7 @@ TEST_F(LyricFinderTest, ErrorOnParse) {
   auto parser = GetParser();
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _)).Times(2).WillRepeatedly(Return(error::kSuccess));
+  EXPECT_CALL(*fetcher, Fetch(_, _, _)).Times(2).WillRepeatedly(Return(error::kSuccess));
   EXPECT_CALL(*parser, Parse(_, _)).Times(2).WillRepeatedly(Return(lyric::SongLyric{}));
 
   std::string artist{"Kaiser Chiefs"};
@@ -272,7 +298,7 @@ TEST_F(LyricFinderTest, ErrorOnParse) {
 
   const lyric::SongLyric expected{};
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
 }
 
@@ -297,7 +323,7 @@ TEST_F(LyricFinderTest, ErrorOnFormattingLyrics) {
       "Just one feeling, just one feeling\n"};
 
   // Setup expectations
-  EXPECT_CALL(*fetcher, Fetch(_, _))
+  EXPECT_CALL(*fetcher, Fetch(_, _, _))
       .Times(2)
       .WillRepeatedly(DoAll(SetArgReferee<1>(raw), Return(error::kSuccess)));
 
@@ -310,7 +336,7 @@ TEST_F(LyricFinderTest, ErrorOnFormattingLyrics) {
 
   const lyric::SongLyric expected{};
 
-  auto song_lyrics = finder->Search(artist, title);
+  auto song_lyrics = finder->Search(artist, title, cancelled);
   EXPECT_THAT(song_lyrics, ElementsAreArray(expected));
 }
 
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "view/base/render_scheduler.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Tests with RenderScheduler class
+ */
+class RenderSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Init(interface::RenderScheduler::kDefaultFrameRate); }
+
+  void TearDown() override { scheduler.reset(); }
+
+  //! Create scheduler with the given frame rate
+  void Init(int frame_rate) {
+    created = Clock::now();
+    scheduler = std::make_unique<interface::RenderScheduler>(
+        [this] {
+          std::scoped_lock lock(mutex);
+          redraws.push_back(Clock::now());
+          notifier.notify_all();
+        },
+        frame_rate);
+  }
+
+  //! Wait until predicate is satisfied (deadline is generous, so a busy machine does not fail it)
+  bool WaitFor(const std::function<bool()>& predicate) {
+    std::unique_lock lock(mutex);
+    return notifier.wait_for(lock, 5s, predicate);
+  }
+
+  //! Wait until scheduler has triggered the given quantity of redraws
+  bool WaitForRedraws(size_t count) {
+    return WaitFor([this, count] { return redraws.size() >= count; });
+  }
+
+  //! Get quantity of redraws triggered
+  size_t GetRedraws() {
+    std::scoped_lock lock(mutex);
+    return redraws.size();
+  }
+
+ protected:
+  std::unique_ptr<interface::RenderScheduler> scheduler;  //!< Render scheduler
+  Clock::time_point created;                              //!< Time when scheduler was created
+
+  std::mutex mutex;                        //!< Control access for redraws
+  std::condition_variable notifier;        //!< Notify when a redraw is triggered
+  std::vector<Clock::time_point> redraws;  //!< Time for each redraw triggered
+};
+
+/* ********************************************************************************************** */
+
+TEST_F(RenderSchedulerTest, MergeRequestsWhileRedrawIsNotHandled) {
+  for (int i = 0; i < 100; i++) scheduler->RequestRedraw();
+
+  ASSERT_TRUE(WaitForRedraws(1));
+
+  // Screen did not handle the first redraw, so it will handle every other request at once
+  auto stats = scheduler->GetStatistics();
+  EXPECT_EQ(stats.requested, 100);
+  EXPECT_EQ(stats.rendered, 1);
+  EXPECT_EQ(stats.merged + stats.dropped, 99);
+
+  // Which means that nothing else is triggered until it does
+  scheduler.reset();
+  EXPECT_EQ(GetRedraws(), 1);
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(RenderSchedulerTest, RequestAfterRedrawHandled) {
+  scheduler->RequestRedraw();
+  ASSERT_TRUE(WaitForRedraws(1));
+
+  // Request sent after screen started handling the last redraw must trigger a new one
+  scheduler->NotifyRedrawHandled();
+  scheduler->RequestRedraw();
+  ASSERT_TRUE(WaitForRedraws(2));
+
+  auto stats = scheduler->GetStatistics();
+  EXPECT_EQ(stats.requested, 2);
+  EXPECT_EQ(stats.rendered, 2);
+  EXPECT_EQ(stats.merged, 0);
+  EXPECT_EQ(stats.dropped, 0);
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(RenderSchedulerTest, LimitRedrawsToFrameRate) {
+  scheduler.reset();
+  Init(10);
+
+  // Keep requesting redraws (and handling them right away) until a few of them are triggered
+  constexpr size_t kRedraws = 4;
+
+  while (GetRedraws() < kRedraws) {
+    size_t count = GetRedraws();
+    for (int i = 0; i < 10; i++) scheduler->RequestRedraw();
+
+    ASSERT_TRUE(WaitForRedraws(count + 1));
+    scheduler->NotifyRedrawHandled();
+  }
+
+  scheduler.reset();
+
+  // At 10 fps, each redraw happens at least a whole frame interval after the previous one was
+  // scheduled (first one is triggered right away), no matter how many requests were made
+  for (size_t i = 1; i < redraws.size(); i++) {
+    EXPECT_GE(redraws[i] - created, i * 100ms) << "redraw=" << i;
+  }
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(RenderSchedulerTest, NoRedrawAfterStop) {
+  scheduler->Stop();
+  scheduler->RequestRedraw();
+
+  // Scheduler thread is joined here, so any redraw would have been triggered by now
+  scheduler.reset();
+  EXPECT_EQ(GetRedraws(), 0);
+}
+
+}  // namespace
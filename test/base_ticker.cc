@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "view/base/ticker.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Tests with Ticker class
+ */
+class TickerTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    // Ticker is shared by every test, so callbacks must not outlive this one (even on failure)
+    for (auto id : ids) ticker.Unregister(id);
+  }
+
+  //! Register callback to increment the given counter
+  void Register(std::chrono::milliseconds interval, int& counter) {
+    ids.push_back(ticker.Register(interval, Increment(counter)));
+  }
+
+  //! Create callback to increment the given counter
+  interface::Ticker::Callback Increment(int& counter) {
+    return [this, &counter] {
+      std::scoped_lock lock(mutex);
+      counter++;
+      notifier.notify_all();
+    };
+  }
+
+  //! Wait until predicate is satisfied (deadline is generous, so a busy machine does not fail it)
+  bool WaitFor(const std::function<bool()>& predicate) {
+    std::unique_lock lock(mutex);
+    return notifier.wait_for(lock, 5s, predicate);
+  }
+
+ protected:
+  interface::Ticker& ticker = interface::Ticker::GetInstance();  //!< Ticker shared by application
+  std::vector<interface::Ticker::Id> ids;                         //!< Callbacks registered
+
+  std::mutex mutex;                  //!< Control access for counters
+  std::condition_variable notifier;  //!< Notify when any counter is incremented
+  int fast = 0;                      //!< Calls to callback with short interval
+  int slow = 0;                      //!< Calls to callback with long interval
+};
+
+/* ********************************************************************************************** */
+
+TEST_F(TickerTest, RunCallbacksUntilUnregistered) {
+  Register(10ms, fast);
+  Register(100ms, slow);
+
+  // Both callbacks share the same thread, each one following its own interval
+  ASSERT_TRUE(WaitFor([this] { return fast >= 10 && slow >= 1; }));
+  ticker.Unregister(ids.front());
+
+  int count, target;
+  {
+    std::scoped_lock lock(mutex);
+    EXPECT_LT(slow, fast);
+    count = fast;
+    target = slow + 2;
+  }
+
+  // After unregistered, callback is never called again (even while ticker keeps running others)
+  ASSERT_TRUE(WaitFor([this, target] { return slow >= target; }));
+
+  std::scoped_lock lock(mutex);
+  EXPECT_EQ(fast, count);
+}
+
+}  // namespace
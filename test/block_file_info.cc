@@ -1,5 +1,8 @@
 #include <gmock/gmock-matchers.h>
 
+#include <chrono>
+#include <iostream>
+
 #include "general/block.h"
 #include "general/utils.h"
 #include "mock/event_dispatcher_mock.h"
@@ -7,6 +10,7 @@
 
 namespace {
 
+using ::testing::HasSubstr;
 using ::testing::StrEq;
 
 /**
@@ -145,4 +149,67 @@ TEST_F(FileInfoTest, UpdateAndClearSongInfo) {
   EXPECT_THAT(rendered, StrEq(expected));
 }
 
+/* ********************************************************************************************** */
+
+TEST_F(FileInfoTest, RenderCachedUntilDirty) {
+  auto component = std::static_pointer_cast<interface::Block>(block);
+
+  // While block is not dirty, last element is reused
+  ftxui::Element first = component->RenderCached();
+  EXPECT_FALSE(component->IsDirty());
+  EXPECT_EQ(first, component->RenderCached());
+
+  // Audio spectrum does not change this block
+  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(model::AudioSpectrum(8, 0.5));
+  EXPECT_FALSE(component->IsAffectedBy(event_bars));
+
+  // But song information does
+  auto event_update = interface::CustomEvent::UpdateSongInfo(model::Song{
+      .filepath = "/some/custom/path/to/song.mp3",
+      .artist = "Yung Buda",
+      .title = "Sorte",
+  });
+  EXPECT_TRUE(component->IsAffectedBy(event_update));
+
+  // Simulate Terminal processing event
+  Process(event_update);
+  component->SetDirty();
+
+  ftxui::Element second = component->RenderCached();
+  EXPECT_NE(first, second);
+
+  ftxui::Render(*screen, second);
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  EXPECT_THAT(rendered, HasSubstr("Yung Buda"));
+}
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TEST_F(FileInfoTest, DISABLED_BenchmarkRenderCached) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kFrames = 20000;
+
+  auto component = std::static_pointer_cast<interface::Block>(block);
+
+  // Simulate frames where only the audio spectrum has changed (so this block has no change at all)
+  auto start = Clock::now();
+  for (int i = 0; i < kFrames; i++) ftxui::Render(*screen, component->Render());
+  auto full = Clock::now() - start;
+
+  start = Clock::now();
+  for (int i = 0; i < kFrames; i++) ftxui::Render(*screen, component->RenderCached());
+  auto cached = Clock::now() - start;
+
+  auto per_frame = [](Clock::duration elapsed) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / kFrames;
+  };
+
+  std::cout << "frames=" << kFrames << " full=" << per_frame(full)
+            << "ns cached=" << per_frame(cached) << "ns\n";
+
+  EXPECT_LT(cached, full);
+}
+
 }  // namespace
@@ -1,6 +1,11 @@
 #include <gmock/gmock-matchers.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "general/block.h"
 #include "general/utils.h"
@@ -14,11 +19,16 @@ namespace {
 using ::testing::_;
 using ::testing::AllOf;
 using ::testing::Field;
+using ::testing::HasSubstr;
 using ::testing::Invoke;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::StrEq;
 using ::testing::VariantWith;
 
+template <typename T>
+using SharedContent = interface::CustomEvent::Shared<T>;
+
 /**
  * @brief Tests with MainContent class
  */
@@ -70,7 +80,7 @@ class MainContentTest : public ::BlockTest {
 
 TEST_F(MainContentTest, InitialRender) {
   auto event_bars =
-      interface::CustomEvent::DrawAudioSpectrum(std::vector<double>(kNumberBars, 0.001));
+      interface::CustomEvent::DrawAudioSpectrum(model::AudioSpectrum(kNumberBars, 0.001));
   Process(event_bars);
 
   ftxui::Render(*screen, block->Render());
@@ -100,7 +110,7 @@ TEST_F(MainContentTest, InitialRender) {
 /* ********************************************************************************************** */
 
 TEST_F(MainContentTest, AnimationHorizontalMirror) {
-  std::vector<double> values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
+  model::AudioSpectrum values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
                              0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06};
 
   auto event_bars = interface::CustomEvent::DrawAudioSpectrum(values);
@@ -132,8 +142,79 @@ TEST_F(MainContentTest, AnimationHorizontalMirror) {
 
 /* ********************************************************************************************** */
 
+TEST_F(MainContentTest, AnimationFromSharedFrames) {
+  auto frames = std::make_shared<model::SharedSpectrum>();
+
+  // Publish some frames, where only the most recent one must be drawn
+  frames->Publish(model::AudioSpectrum(22, 0.5));
+  frames->Publish(model::AudioSpectrum{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33,
+                                       0.24, 0.15, 0.06, 0.99, 0.90, 0.81, 0.72, 0.61,
+                                       0.52, 0.41, 0.33, 0.24, 0.15, 0.06});
+
+  // Event only notifies that a new frame is available
+  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(frames);
+  Process(event_bars);
+
+  ftxui::Render(*screen, block->Render());
+
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  std::string expected = R"(
+╭ 1:visualizer  2:equalizer  3:lyric ─────────────────────────────────────────[F12:help]───[X]╮
+│                                           ▇▇▇ ▇▇▇                                           │
+│                                       ▆▆▆ ███ ███ ▆▆▆                                       │
+│                                   ▅▅▅ ███ ███ ███ ███ ▅▅▅                                   │
+│                               ▃▃▃ ███ ███ ███ ███ ███ ███ ▃▃▃                               │
+│                               ███ ███ ███ ███ ███ ███ ███ ███                               │
+│                           ███ ███ ███ ███ ███ ███ ███ ███ ███ ███                           │
+│                       ▇▇▇ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ▇▇▇                       │
+│                   ▃▃▃ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ▃▃▃                   │
+│               ▃▃▃ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ▃▃▃               │
+│           ▁▁▁ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ▁▁▁           │
+│           ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███           │
+│       ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███       │
+│   ▇▇▇ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ███ ▇▇▇   │
+╰─────────────────────────────────────────────────────────────────────────────────────────────╯)";
+
+  EXPECT_THAT(rendered, StrEq(expected));
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(MainContentTest, AnimationFallsByGravity) {
+  auto frames = std::make_shared<model::SharedSpectrum>();
+
+  frames->Publish(model::AudioSpectrum{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33,
+                                       0.24, 0.15, 0.06, 0.99, 0.90, 0.81, 0.72, 0.61,
+                                       0.52, 0.41, 0.33, 0.24, 0.15, 0.06});
+
+  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(frames);
+  Process(event_bars);
+
+  ftxui::Render(*screen, block->Render());
+
+  // Clear bars, the same way that audio analysis does when song is paused
+  frames->Publish(model::AudioSpectrum(22, 0.001));
+  Process(event_bars);
+
+  // As bars are still falling, visualizer must ask for another redraw
+  EXPECT_CALL(*dispatcher, SendEvent(Field(&interface::CustomEvent::id,
+                                           interface::CustomEvent::Identifier::DrawAudioSpectrum)))
+      .Times(1);
+
+  screen->Clear();
+  ftxui::Render(*screen, block->Render());
+
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  // Highest bars did not have time to fall yet
+  EXPECT_THAT(rendered, HasSubstr("▇▇▇ ▇▇▇"));
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(MainContentTest, AnimationVerticalMirror) {
-  std::vector<double> values{0.1, 0.2, 0.3,  0.4, 0.5,  0.4, 0.3,  0.2, 0.1,  0.2, 0.3,
+  model::AudioSpectrum values{0.1, 0.2, 0.3,  0.4, 0.5,  0.4, 0.3,  0.2, 0.1,  0.2, 0.3,
                              0.4, 0.5, 0.55, 0.6, 0.65, 0.7, 0.75, 0.8, 0.85, 0.9, 0.95,
 
                              0.1, 0.2, 0.3,  0.4, 0.5,  0.4, 0.3,  0.2, 0.1,  0.2, 0.3,
@@ -180,7 +261,7 @@ TEST_F(MainContentTest, AnimationVerticalMirror) {
 /* ********************************************************************************************** */
 
 TEST_F(MainContentTest, AnimationMono) {
-  std::vector<double> values{0.1, 0.2,  0.3, 0.4,  0.5, 0.6,  0.5, 0.4, 0.3, 0.2, 0.1,
+  model::AudioSpectrum values{0.1, 0.2,  0.3, 0.4,  0.5, 0.6,  0.5, 0.4, 0.3, 0.2, 0.1,
                              0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5, 0.6, 0.7, 0.8, 0.9,
 
                              0.1, 0.2,  0.3, 0.4,  0.5, 0.6,  0.5, 0.4, 0.3, 0.2, 0.1,
@@ -234,7 +315,7 @@ TEST_F(MainContentTest, AnimationMono) {
 /* ********************************************************************************************** */
 
 TEST_F(MainContentTest, IncreaseAndDecreaseBarWidth) {
-  std::vector<double> values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
+  model::AudioSpectrum values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
                              0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06};
 
   auto event_bars = interface::CustomEvent::DrawAudioSpectrum(values);
@@ -272,7 +353,7 @@ TEST_F(MainContentTest, IncreaseAndDecreaseBarWidth) {
   block->OnEvent(ftxui::Event::Character('.'));
   block->OnEvent(ftxui::Event::Character('.'));
 
-  values = std::vector<double>{0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
+  values = model::AudioSpectrum{0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
                                0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06};
 
   event_bars = interface::CustomEvent::DrawAudioSpectrum(values);
@@ -313,7 +394,7 @@ TEST_F(MainContentTest, IncreaseAndDecreaseBarWidth) {
   block->OnEvent(ftxui::Event::Character(','));
   block->OnEvent(ftxui::Event::Character(','));
 
-  values = std::vector<double>{
+  values = model::AudioSpectrum{
       0.99, 0.90, 0.80, 0.70, 0.60, 0.48, 0.40, 0.35, 0.30, 0.24, 0.20, 0.15, 0.10, 0.06, 0.02,
       0.99, 0.90, 0.80, 0.70, 0.60, 0.48, 0.40, 0.35, 0.30, 0.24, 0.20, 0.15, 0.10, 0.06, 0.02,
   };
@@ -353,7 +434,7 @@ TEST_F(MainContentTest, VisualizerOnFullscreen) {
   auto tab_viewer = std::static_pointer_cast<interface::MainContent>(block);
 
   // Send audio data to show on visualizer
-  std::vector<double> values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
+  model::AudioSpectrum values{0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06,
                              0.99, 0.90, 0.81, 0.72, 0.61, 0.52, 0.41, 0.33, 0.24, 0.15, 0.06};
 
   auto event_bars = interface::CustomEvent::DrawAudioSpectrum(values);
@@ -465,7 +546,8 @@ TEST_F(MainContentTest, ModifyEqualizerAndApply) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<EqualizerPreset>(audio_filters)))));
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(audio_filters))))));
 
   // Apply EQ
   block->OnEvent(ftxui::Event::Character('a'));
@@ -532,7 +614,8 @@ TEST_F(MainContentTest, ModifyEqualizerAndReset) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<model::EqualizerPreset>(_)))))
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(_))))))
       .Times(0);
 
   // Reset EQ
@@ -607,7 +690,8 @@ TEST_F(MainContentTest, SelectOtherPresetAndApply) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ApplyAudioFilters),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::EqualizerPreset>(audio_filters)))));
+                                    VariantWith<SharedContent<model::EqualizerPreset>>(
+                                        Pointee(audio_filters))))));
 
   // Select and apply Electronic EQ
   typed = " a";
@@ -652,7 +736,8 @@ TEST_F(MainContentTest, AttemptToModifyFixedPreset) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ApplyAudioFilters),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::EqualizerPreset>(audio_filters)))));
+                                    VariantWith<SharedContent<model::EqualizerPreset>>(
+                                        Pointee(audio_filters))))));
 
   // Using keybindings for navigation, open preset picker, select and apply "Pop"
   std::string typed{"l jjj a"};
@@ -686,7 +771,8 @@ TEST_F(MainContentTest, AttemptToModifyFixedPreset) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<model::EqualizerPreset>(_)))))
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(_))))))
       .Times(0);
 
   // Attempt to modify some frequency bars and apply
@@ -732,7 +818,8 @@ TEST_F(MainContentTest, AttemptToResetFixedPreset) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ApplyAudioFilters),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::EqualizerPreset>(audio_filters)))));
+                                    VariantWith<SharedContent<model::EqualizerPreset>>(
+                                        Pointee(audio_filters))))));
 
   // Using keybindings for navigation, open preset picker, select and apply "Rock"
   std::string typed{"l jjjj a"};
@@ -766,7 +853,8 @@ TEST_F(MainContentTest, AttemptToResetFixedPreset) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<model::EqualizerPreset>(_)))))
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(_))))))
       .Times(0);
 
   // Attempt to reset EQ
@@ -824,7 +912,8 @@ TEST_F(MainContentTest, ModifyEqualizerChangePresetAndSwitchback) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<EqualizerPreset>(audio_filters)))));
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(audio_filters))))));
 
   // Apply EQ
   block->OnEvent(ftxui::Event::Character('a'));
@@ -862,7 +951,8 @@ TEST_F(MainContentTest, ModifyEqualizerChangePresetAndSwitchback) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ApplyAudioFilters),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::EqualizerPreset>(electronic_preset)))));
+                                    VariantWith<SharedContent<model::EqualizerPreset>>(
+                                        Pointee(electronic_preset))))));
 
   typed = "l jj a";
   utils::QueueCharacterEvents(*block, typed);
@@ -897,7 +987,8 @@ TEST_F(MainContentTest, ModifyEqualizerChangePresetAndSwitchback) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::ApplyAudioFilters),
-          Field(&interface::CustomEvent::content, VariantWith<EqualizerPreset>(audio_filters)))));
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::EqualizerPreset>>(Pointee(audio_filters))))));
 
   // Switchback to "Custom" preset
   typed = "k a";
@@ -964,8 +1055,8 @@ TEST_F(MainContentTest, FetchSongLyrics) {
   std::string expected_title{"Midnight Tokyo"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1057,8 +1148,8 @@ TEST_F(MainContentTest, FetchSongLyricsFailed) {
   std::string expected_title{"Miss You"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1144,8 +1235,8 @@ TEST_F(MainContentTest, FetchSongLyricsWithoutMetadata) {
   std::string expected_title{"Lucid Memories"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1235,10 +1326,10 @@ TEST_F(MainContentTest, FetchSongLyricsWithDifferentFilenames) {
                                         const std::string& expected_title, int times = 1) {
     if (times == 0)
       // Setup expectations before start fetching song lyrics
-      EXPECT_CALL(*finder, Search(expected_artist, expected_title)).Times(0);
+      EXPECT_CALL(*finder, Search(expected_artist, expected_title, _)).Times(0);
     else
       // Setup expectations before start fetching song lyrics
-      EXPECT_CALL(*finder, Search(expected_artist, expected_title))
+      EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
           .WillRepeatedly(Return(lyric::SongLyric{}));
 
     // Send event to notify that song has started playing
@@ -1282,8 +1373,8 @@ TEST_F(MainContentTest, FetchSongLyricsAndClear) {
   std::string expected_title{"Show Me"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1358,6 +1449,94 @@ TEST_F(MainContentTest, FetchSongLyricsAndClear) {
 
 /* ********************************************************************************************** */
 
+TEST_F(MainContentTest, CancelFetchSongLyricsOnSongChange) {
+  // Set focus on tab item 3
+  block->OnEvent(ftxui::Event::Character('3'));
+
+  auto finder = GetFinder();
+
+  // Synchronize test with fetcher thread
+  std::mutex mutex;
+  std::condition_variable notifier;
+  bool started = false, refreshed = false;
+
+  auto notify = [&](bool& flag) {
+    std::scoped_lock lock(mutex);
+    flag = true;
+    notifier.notify_all();
+  };
+
+  auto wait_for = [&](const bool& flag) {
+    std::unique_lock lock(mutex);
+    return notifier.wait_for(lock, std::chrono::seconds(5), [&flag] { return flag; });
+  };
+
+  // Setup expectations for first song, where fetch only finishes after being cancelled
+  EXPECT_CALL(*finder, Search("Deko", "Midnight Tokyo", _))
+      .WillOnce(Invoke([&](const std::string&, const std::string&,
+                           const std::atomic<bool>& cancelled) {
+        notify(started);
+
+        // Simulate a transfer stuck on connecting to host
+        for (int i = 0; i < 5000 && !cancelled; i++) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        EXPECT_TRUE(cancelled);
+        return lyric::SongLyric{"Lyrics from a song that is not playing anymore\n"};
+      }));
+
+  // And for the second song
+  EXPECT_CALL(*finder, Search("Joey Bada$$", "Show Me", _))
+      .WillOnce(Return(lyric::SongLyric{
+          "Just imagine the lyrics\n"
+          "In this block\n",
+      }));
+
+  // Only result from second song must be notified to UI
+  EXPECT_CALL(*dispatcher, SendEvent(Field(&interface::CustomEvent::id,
+                                           interface::CustomEvent::Identifier::Refresh)))
+      .WillOnce(Invoke([&](const interface::CustomEvent&) { notify(refreshed); }));
+
+  // Send event to notify that song has started playing
+  model::Song audio{.filepath = "/contains/Deko-Midnight Tokyo.mp3"};
+  Process(interface::CustomEvent::UpdateSongInfo(audio));
+
+  // Change song while first fetch is still executing
+  ASSERT_TRUE(wait_for(started));
+
+  audio = model::Song{.filepath = "/contains/Joey Bada$$-Show Me.mp3"};
+  Process(interface::CustomEvent::UpdateSongInfo(audio));
+
+  // Wait for fetcher thread to finish both of them
+  ASSERT_TRUE(wait_for(refreshed));
+
+  ftxui::Render(*screen, block->Render());
+
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  std::string expected = R"(
+╭ 1:visualizer  2:equalizer  3:lyric ─────────────────────────────────────────[F12:help]───[X]╮
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                  Just imagine the lyrics                                    │
+│                                  In this block                                              │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+│                                                                                             │
+╰─────────────────────────────────────────────────────────────────────────────────────────────╯)";
+
+  EXPECT_THAT(rendered, StrEq(expected));
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(MainContentTest, FetchScrollableSongLyrics) {
   // Set focus on tab item 3
   block->OnEvent(ftxui::Event::Character('3'));
@@ -1368,8 +1547,8 @@ TEST_F(MainContentTest, FetchScrollableSongLyrics) {
   std::string expected_title{"Innerbloom"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1554,8 +1733,8 @@ TEST_F(MainContentTest, FetchSongLyricsOnBackground) {
   std::string expected_title{"Rich Girls"};
 
   // Setup expectations before start fetching song lyrics
-  EXPECT_CALL(*finder, Search(expected_artist, expected_title))
-      .WillOnce(Invoke([](const std::string&, const std::string&) {
+  EXPECT_CALL(*finder, Search(expected_artist, expected_title, _))
+      .WillOnce(Invoke([](const std::string&, const std::string&, const std::atomic<bool>&) {
         // Wait a bit, to simulate execution of Finder async task
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
@@ -1669,7 +1848,7 @@ TEST_F(MockMainContentTest, CheckFocus) {
   EXPECT_CALL(*main_content_mock, OnFocus());
   block->OnEvent(ftxui::Event::Character('1'));
 
-  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(std::vector<double>(22, 0.001));
+  auto event_bars = interface::CustomEvent::DrawAudioSpectrum(model::AudioSpectrum(22, 0.001));
   Process(event_bars);
 
   ftxui::Render(*screen, block->Render());
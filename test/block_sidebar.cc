@@ -2,8 +2,12 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <thread>
 
 #include "ftxui/component/component.hpp"
 #include "ftxui/component/component_base.hpp"
@@ -29,11 +33,16 @@ using ::testing::Field;
 using ::testing::HasSubstr;
 using ::testing::InSequence;
 using ::testing::Invoke;
+using ::testing::Not;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 using ::testing::StrEq;
 using ::testing::VariantWith;
 
+template <typename T>
+using SharedContent = interface::CustomEvent::Shared<T>;
+
 //! Create custom matcher to compare only filename from std::filesystem::path
 MATCHER_P(IsSameFilename, n, "") { return arg.filename() == n; }
 
@@ -78,6 +87,24 @@ class SidebarTest : public ::BlockTest {
   //! Getter for current dir from ListDirectory
   auto GetCurrentDir() -> std::filesystem::path { return GetListDirectory()->GetCurrentDir(); }
 
+  //! Getter for file menu from ListDirectory
+  auto GetFileMenu() -> interface::internal::FileMenu& {
+    return GetListDirectory()->menu_->actual();
+  }
+
+  //! Hacky method to drop entries from files tab_item (without rendering it again)
+  void ResizeFiles(size_t size) { GetFileMenu().entries_.resize(size); }
+
+  //! Hacky method to simulate that events from directory were lost (like an inotify overflow)
+  void ForceWatcherOverflow() {
+    auto& state = GetFileMenu().watcher_->state_;
+    std::scoped_lock lock(state->mutex);
+    state->overflow = true;
+  }
+
+  //! Check if directory is still being listed in background
+  bool IsListing() { return GetFileMenu().listing_ != nullptr; }
+
   //! Hacky method to add new entry in files tab_item
   void EmplaceFile(const std::filesystem::path& entry) {
     auto files = GetListDirectory();
@@ -142,6 +169,8 @@ TEST_F(SidebarTest, InitialRender) {
 │▶ ..                                │
 │  audio_lyric_finder.cc             │
 │  audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -149,8 +178,6 @@ TEST_F(SidebarTest, InitialRender) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -158,6 +185,24 @@ TEST_F(SidebarTest, InitialRender) {
 
 /* ********************************************************************************************** */
 
+TEST_F(SidebarTest, DrawCachedRenderAfterEntriesRemoved) {
+  auto component = std::static_pointer_cast<interface::Block>(block);
+  ftxui::Element cached = component->RenderCached();
+
+  // Remove most entries without rendering block again (entries are only created when drawn)
+  ResizeFiles(2);
+
+  // Element from cache must only draw entries that still exist
+  ftxui::Render(*screen, cached);
+
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  EXPECT_THAT(rendered, HasSubstr("audio_lyric_finder.cc"));
+  EXPECT_THAT(rendered, Not(HasSubstr("audio_player.cc")));
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(SidebarTest, NavigateOnMenu) {
   block->OnEvent(ftxui::Event::ArrowDown);
   block->OnEvent(ftxui::Event::Tab);
@@ -175,15 +220,15 @@ TEST_F(SidebarTest, NavigateOnMenu) {
 │  ..                                │
 │  audio_lyric_finder.cc             │
 │  audio_player.cc                   │
-│▶ block_file_info.cc                │
+│▶ base_render_scheduler.cc          │
+│  base_ticker.cc                    │
+│  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
 │  block_sidebar.cc                  │
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -194,6 +239,9 @@ TEST_F(SidebarTest, NavigateOnMenu) {
 TEST_F(SidebarTest, NavigateToMockDir) {
   block->OnEvent(ftxui::Event::End);
   block->OnEvent(ftxui::Event::ArrowUp);
+  block->OnEvent(ftxui::Event::ArrowUp);
+  block->OnEvent(ftxui::Event::ArrowUp);
+  block->OnEvent(ftxui::Event::ArrowUp);
   block->OnEvent(ftxui::Event::Return);
 
   ftxui::Render(*screen, block->Render());
@@ -240,14 +288,14 @@ TEST_F(SidebarTest, EnterOnSearchMode) {
 │▶ ..                                │
 │  audio_lyric_finder.cc             │
 │  audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
 │  block_sidebar.cc                  │
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
-│  driver_fftw.cc                    │
-│  general                           │
 │Search:                             │
 ╰────────────────────────────────────╯)";
 
@@ -274,6 +322,8 @@ TEST_F(SidebarTest, SingleCharacterInSearchMode) {
 │test                                │
 │▶ audio_lyric_finder.cc             │
 │  audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -281,8 +331,6 @@ TEST_F(SidebarTest, SingleCharacterInSearchMode) {
 │  CMakeLists.txt                    │
 │  driver_fftw.cc                    │
 │  general                           │
-│  middleware_media_controller.cc    │
-│  util_argparser.cc                 │
 │Search:e                            │
 ╰────────────────────────────────────╯)";
 
@@ -390,6 +438,8 @@ TEST_F(SidebarTest, EnterAndExitSearchMode) {
 │▶ ..                                │
 │  audio_lyric_finder.cc             │
 │  audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -397,8 +447,6 @@ TEST_F(SidebarTest, EnterAndExitSearchMode) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -429,6 +477,8 @@ TEST_F(SidebarTest, EnterSearchModeTypeKeybindAndExit) {
 │▶ ..                                │
 │  audio_lyric_finder.cc             │
 │  audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -436,8 +486,6 @@ TEST_F(SidebarTest, EnterSearchModeTypeKeybindAndExit) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -486,6 +534,8 @@ TEST_F(SidebarTest, EnterSearchModeAndNotifyFileSelection) {
 │  ..                                │
 │  audio_lyric_finder.cc             │
 │▶ audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -493,8 +543,6 @@ TEST_F(SidebarTest, EnterSearchModeAndNotifyFileSelection) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -555,6 +603,8 @@ TEST_F(SidebarTest, NotifyFileSelection) {
 │  ..                                │
 │  audio_lyric_finder.cc             │
 │▶ audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -562,8 +612,6 @@ TEST_F(SidebarTest, NotifyFileSelection) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -590,9 +638,6 @@ TEST_F(SidebarTest, RunTextAnimation) {
   std::string expected = R"(
 ╭ F1:files  F2:playlist ─────────────╮
 │test                                │
-│  block_file_info.cc                │
-│  block_main_content.cc             │
-│  block_media_player.cc             │
 │  block_sidebar.cc                  │
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
@@ -601,6 +646,9 @@ TEST_F(SidebarTest, RunTextAnimation) {
 │  middleware_media_controller.cc    │
 │  mock                              │
 │  util_argparser.cc                 │
+│  util_file_handler.cc              │
+│  util_library_index.cc             │
+│  util_search_index.cc              │
 │▶ this_is_a_really_long_pathname_to_│
 ╰────────────────────────────────────╯)";
 
@@ -619,9 +667,6 @@ TEST_F(SidebarTest, RunTextAnimation) {
   expected = R"(
 ╭ F1:files  F2:playlist ─────────────╮
 │test                                │
-│  block_file_info.cc                │
-│  block_main_content.cc             │
-│  block_media_player.cc             │
 │  block_sidebar.cc                  │
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
@@ -630,6 +675,9 @@ TEST_F(SidebarTest, RunTextAnimation) {
 │  middleware_media_controller.cc    │
 │  mock                              │
 │  util_argparser.cc                 │
+│  util_file_handler.cc              │
+│  util_library_index.cc             │
+│  util_search_index.cc              │
 │▶ is_a_really_long_pathname_to_test.│
 ╰────────────────────────────────────╯)";
 
@@ -696,6 +744,7 @@ TEST_F(SidebarTest, NavigateAndEraseCharactersOnSearch) {
   block->OnEvent(ftxui::Event::ArrowRight);
   block->OnEvent(ftxui::Event::Backspace);
 
+  // Search is fuzzy, so entries containing all typed characters in the same order still match
   ftxui::Render(*screen, block->Render());
 
   std::string rendered = utils::FilterAnsiCommands(screen->ToString());
@@ -703,10 +752,10 @@ TEST_F(SidebarTest, NavigateAndEraseCharactersOnSearch) {
   std::string expected = R"(
 ╭ F1:files  F2:playlist ─────────────╮
 │test                                │
-│                                    │
-│                                    │
-│                                    │
-│                                    │
+│▶ block_file_info.cc                │
+│  block_main_content.cc             │
+│  block_media_player.cc             │
+│  block_sidebar.cc                  │
 │                                    │
 │                                    │
 │                                    │
@@ -737,13 +786,13 @@ TEST_F(SidebarTest, ScrollMenuOnBigList) {
   std::string expected = R"(
 ╭ F1:files  F2:playlist ─────────────╮
 │test                                │
-│  CMakeLists.txt                    │
-│  dialog_playlist.cc                │
-│  driver_fftw.cc                    │
 │  general                           │
 │  middleware_media_controller.cc    │
 │  mock                              │
 │  util_argparser.cc                 │
+│  util_file_handler.cc              │
+│  util_library_index.cc             │
+│  util_search_index.cc              │
 │  some_music_0.mp3                  │
 │  some_music_1.mp3                  │
 │  some_music_2.mp3                  │
@@ -756,6 +805,131 @@ TEST_F(SidebarTest, ScrollMenuOnBigList) {
 
 /* ********************************************************************************************** */
 
+TEST_F(SidebarTest, ClickOnEntryAfterScrollingBigList) {
+  // Hacky method to add new entries until it fills the screen
+  for (int i = 0; i < 5; i++) {
+    EmplaceFile(std::filesystem::path{"some_music_" + std::to_string(i) + ".mp3"});
+  }
+
+  // Navigate to the end, so list is scrolled and only the last entries are rendered
+  block->OnEvent(ftxui::Event::End);
+  ftxui::Render(*screen, block->Render());
+
+  // Setup expectation for file selection, based on entry under mouse cursor
+  std::filesystem::path file{"middleware_media_controller.cc"};
+  EXPECT_CALL(*dispatcher,
+              SendEvent(AllOf(Field(&interface::CustomEvent::id,
+                                    interface::CustomEvent::Identifier::NotifyFileSelection),
+                              Field(&interface::CustomEvent::content,
+                                    VariantWith<std::filesystem::path>(IsSameFilename(file))))))
+      .Times(1);
+
+  // Click on second line from list (below border and title)
+  auto click = ftxui::Event::Mouse("", ftxui::Mouse{.button = ftxui::Mouse::Left,
+                                                    .motion = ftxui::Mouse::Released,
+                                                    .x = 5,
+                                                    .y = 3});
+  block->OnEvent(click);
+
+  // As clicked entry is now selected, list is scrolled to keep it centered
+  screen->Clear();
+  ftxui::Render(*screen, block->Render());
+
+  std::string rendered = utils::FilterAnsiCommands(screen->ToString());
+
+  std::string expected = R"(
+╭ F1:files  F2:playlist ─────────────╮
+│test                                │
+│  block_sidebar.cc                  │
+│  CMakeLists.txt                    │
+│  dialog_playlist.cc                │
+│  driver_fftw.cc                    │
+│  general                           │
+│▶ middleware_media_controller.cc    │
+│  mock                              │
+│  util_argparser.cc                 │
+│  util_file_handler.cc              │
+│  util_library_index.cc             │
+│  util_search_index.cc              │
+│  some_music_0.mp3                  │
+╰────────────────────────────────────╯)";
+
+  EXPECT_THAT(rendered, StrEq(expected));
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(SidebarTest, ApplyDirectoryChangesOnlyOnRefresh) {
+  const auto dir_path = std::filesystem::temp_directory_path() / "spectrum_test_sidebar";
+  std::filesystem::remove_all(dir_path);
+  std::filesystem::create_directories(dir_path);
+
+  // Both listing and watcher ask for a refresh whenever something new arrives
+  EXPECT_CALL(*dispatcher, SendEvent(Field(&interface::CustomEvent::id,
+                                           interface::CustomEvent::Identifier::Refresh)))
+      .Times(::testing::AnyNumber());
+
+  ASSERT_TRUE(GetFileMenu().RefreshList(dir_path));
+
+  std::ofstream(dir_path / "new.mp3") << "new";
+
+  // Render never changes entries by itself, even after watcher has noticed the new file
+  for (int i = 0; i < 20; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ftxui::Render(*screen, block->Render());
+    EXPECT_THAT(utils::FilterAnsiCommands(screen->ToString()), Not(HasSubstr("new.mp3")));
+  }
+
+  // Only refresh event applies changes from directory
+  bool found = false;
+
+  for (int i = 0; i < 500 && !found; i++) {
+    Process(interface::CustomEvent::Refresh());
+    ftxui::Render(*screen, block->Render());
+
+    found = utils::FilterAnsiCommands(screen->ToString()).find("new.mp3") != std::string::npos;
+    if (!found) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  EXPECT_TRUE(found);
+
+  std::filesystem::remove_all(dir_path);
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(SidebarTest, KeepActiveEntryAfterLosingTrackOfChanges) {
+  // Both listing and watcher ask for a refresh whenever something new arrives
+  EXPECT_CALL(*dispatcher, SendEvent(Field(&interface::CustomEvent::id,
+                                           interface::CustomEvent::Identifier::Refresh)))
+      .Times(::testing::AnyNumber());
+
+  ASSERT_FALSE(IsListing());
+
+  // Select some entry from the middle of the list
+  for (int i = 0; i < 5; i++) block->OnEvent(ftxui::Event::ArrowDown);
+
+  auto active = GetFileMenu().GetActiveEntry();
+  ASSERT_TRUE(active);
+  ASSERT_NE(active->filename(), "..");
+
+  // Next refresh must list whole directory again, as its changes cannot be trusted anymore
+  ForceWatcherOverflow();
+  Process(interface::CustomEvent::Refresh());
+
+  for (int i = 0; i < 500 && IsListing(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    Process(interface::CustomEvent::Refresh());
+  }
+
+  ASSERT_FALSE(IsListing());
+
+  // Even though list was reset, the same entry must still be selected
+  EXPECT_EQ(GetFileMenu().GetActiveEntry(), active);
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(SidebarTest, PlayNextFileAfterFinished) {
   InSequence seq;
   auto derived = GetListDirectory();
@@ -783,6 +957,8 @@ TEST_F(SidebarTest, PlayNextFileAfterFinished) {
 │  ..                                │
 │  audio_lyric_finder.cc             │
 │▶ audio_player.cc                   │
+│  base_render_scheduler.cc          │
+│  base_ticker.cc                    │
 │  block_file_info.cc                │
 │  block_main_content.cc             │
 │  block_media_player.cc             │
@@ -790,8 +966,6 @@ TEST_F(SidebarTest, PlayNextFileAfterFinished) {
 │  CMakeLists.txt                    │
 │  dialog_playlist.cc                │
 │  driver_fftw.cc                    │
-│  general                           │
-│  middleware_media_controller.cc    │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -813,7 +987,7 @@ TEST_F(SidebarTest, PlayNextFileAfterFinished) {
   auto event_finish = interface::CustomEvent::UpdateSongState(
       model::Song::CurrentInformation{.state = model::Song::MediaState::Finished});
 
-  std::filesystem::path next_file{LISTDIR_PATH + std::string{"/block_file_info.cc"}};
+  std::filesystem::path next_file{LISTDIR_PATH + std::string{"/base_render_scheduler.cc"}};
 
   EXPECT_CALL(*dispatcher,
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
@@ -825,10 +999,10 @@ TEST_F(SidebarTest, PlayNextFileAfterFinished) {
   derived->OnCustomEvent(event_finish);
 
   // Simulate player sending event with new song update
-  auto& content = std::get<model::Song>(event_update.content);
-  content.filepath = next_file;
+  auto song = event_update.GetContent<model::Song>();
+  song.filepath = next_file;
 
-  derived->OnCustomEvent(event_update);
+  derived->OnCustomEvent(interface::CustomEvent::UpdateSongInfo(song));
   EXPECT_EQ(next_file, GetCurrentPlaying());
 }
 
@@ -839,7 +1013,7 @@ TEST_F(SidebarTest, StartPlayingLastFileAndPlayNextAfterFinished) {
   auto derived = GetListDirectory();
 
   // Setup expectation to play last file
-  std::filesystem::path file{LISTDIR_PATH + std::string{"/util_argparser.cc"}};
+  std::filesystem::path file{LISTDIR_PATH + std::string{"/util_search_index.cc"}};
   EXPECT_CALL(*dispatcher,
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::NotifyFileSelection),
@@ -857,9 +1031,6 @@ TEST_F(SidebarTest, StartPlayingLastFileAndPlayNextAfterFinished) {
   std::string expected = R"(
 ╭ F1:files  F2:playlist ─────────────╮
 │test                                │
-│  audio_player.cc                   │
-│  block_file_info.cc                │
-│  block_main_content.cc             │
 │  block_media_player.cc             │
 │  block_sidebar.cc                  │
 │  CMakeLists.txt                    │
@@ -868,7 +1039,10 @@ TEST_F(SidebarTest, StartPlayingLastFileAndPlayNextAfterFinished) {
 │  general                           │
 │  middleware_media_controller.cc    │
 │  mock                              │
-│▶ util_argparser.cc                 │
+│  util_argparser.cc                 │
+│  util_file_handler.cc              │
+│  util_library_index.cc             │
+│▶ util_search_index.cc              │
 ╰────────────────────────────────────╯)";
 
   EXPECT_THAT(rendered, StrEq(expected));
@@ -902,10 +1076,10 @@ TEST_F(SidebarTest, StartPlayingLastFileAndPlayNextAfterFinished) {
   derived->OnCustomEvent(event_finish);
 
   // Simulate player sending event with new song update
-  auto& content = std::get<model::Song>(event_update.content);
-  content.filepath = next_file;
+  auto song = event_update.GetContent<model::Song>();
+  song.filepath = next_file;
 
-  derived->OnCustomEvent(event_update);
+  derived->OnCustomEvent(interface::CustomEvent::UpdateSongInfo(song));
   EXPECT_EQ(next_file, GetCurrentPlaying());
 }
 
@@ -1189,7 +1363,8 @@ TEST_F(SidebarTest, SearchOnPlaylistAndNotify) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::NotifyPlaylistSelection),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::Playlist>(playlist)))));
+                                    VariantWith<SharedContent<model::Playlist>>(
+                                        Pointee(playlist))))));
 
   // Execute action on selected entry
   block->OnEvent(ftxui::Event::Return);
@@ -1254,7 +1429,8 @@ TEST_F(SidebarTest, NotifyLastPlaylist) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::NotifyPlaylistSelection),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::Playlist>(playlist)))));
+                                    VariantWith<SharedContent<model::Playlist>>(
+                                        Pointee(playlist))))));
 
   // Execute action on selected entry
   block->OnEvent(ftxui::Event::Return);
@@ -1665,7 +1841,8 @@ TEST_F(SidebarTest, ShowPlaylistManagerWithKeybindings) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ShowQuestionDialog),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::QuestionData>(expected_question)))))
+                                    VariantWith<SharedContent<model::QuestionData>>(
+                                        Pointee(expected_question))))))
       .WillOnce(Invoke([](const interface::CustomEvent& event) {
         // Check that one of these callbacks (yes) are not null and callable
         const auto& question_content = event.GetContent<model::QuestionData>();
@@ -1849,7 +2026,8 @@ TEST_F(SidebarTest, DeleteExistentPlaylist) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ShowQuestionDialog),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::QuestionData>(expected_question)))))
+                                    VariantWith<SharedContent<model::QuestionData>>(
+                                        Pointee(expected_question))))))
       .WillOnce(Invoke([&](const interface::CustomEvent& event) {
         // Check that one of these callbacks (yes) are not null and callable
         const auto& question_content = event.GetContent<model::QuestionData>();
@@ -1983,7 +2161,8 @@ TEST_F(SidebarTest, StartEmptyAddNewPlaylistAndCheckButtonState) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::ShowQuestionDialog),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::QuestionData>(expected_question)))))
+                                    VariantWith<SharedContent<model::QuestionData>>(
+                                        Pointee(expected_question))))))
       .WillOnce(Invoke([&](const interface::CustomEvent& event) {
         // Check that one of these callbacks (yes) are not null and callable
         const auto& question_content = event.GetContent<model::QuestionData>();
@@ -21,10 +21,14 @@ using ::testing::Eq;
 using ::testing::Field;
 using ::testing::Invoke;
 using ::testing::MockFunction;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::StrEq;
 using ::testing::VariantWith;
 
+template <typename T>
+using SharedContent = interface::CustomEvent::Shared<T>;
+
 /**
  * @brief Tests with PlaylistDialog class
  */
@@ -83,6 +87,8 @@ TEST_F(PlaylistDialogTest, InitialRenderWithCreate) {
 ║      │▶ ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -94,11 +100,9 @@ TEST_F(PlaylistDialogTest, InitialRenderWithCreate) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -141,6 +145,8 @@ TEST_F(PlaylistDialogTest, InitialRenderWithModify) {
 ║      │▶ ..                          ││  chilling 2.mp3              │      ║
 ║      │  audio_lyric_finder.cc       ││  chilling 3.mp3              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -152,11 +158,9 @@ TEST_F(PlaylistDialogTest, InitialRenderWithModify) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -188,7 +192,7 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
   EXPECT_CALL(contains_audio_cb, Call).Times(2).WillRepeatedly(Return(true));
 
   // Navigate, add one file, then search and add another one
-  std::string typed{"jjj /fftw"};
+  std::string typed{"jjjjj /fftw"};
   utils::QueueCharacterEvents(*dialog, typed);
 
   // Setup expectation for event enabling global mode again
@@ -211,6 +215,8 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  ..                          ││  driver_fftw.cc              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │▶ block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -222,11 +228,9 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -261,6 +265,8 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  ..                          ││▶ block_main_content.cc       │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │▶ block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -272,11 +278,9 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -323,6 +327,8 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  ..                          ││▶ block_main_content.cc       │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │▶ block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -334,11 +340,9 @@ TEST_F(PlaylistDialogTest, NavigateSearchAndCreatePlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -365,7 +369,7 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndCreateNewPlaylistOnlyAfterValidName)
   EXPECT_CALL(contains_audio_cb, Call).WillOnce(Return(true));
 
   // Focus playlist menu, add a song and focus playlist menu
-  std::string typed{"jjjjj l"};
+  std::string typed{"jjjjjjj l"};
   utils::QueueCharacterEvents(*dialog, typed);
 
   // Enter on rename mode and cancel it
@@ -393,6 +397,8 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndCreateNewPlaylistOnlyAfterValidName)
 ║      │  ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │▶ block_media_player.cc       ││                              │      ║
@@ -404,11 +410,9 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndCreateNewPlaylistOnlyAfterValidName)
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -456,6 +460,8 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndCreateNewPlaylistOnlyAfterValidName)
 ║      │  ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │▶ block_media_player.cc       ││                              │      ║
@@ -467,11 +473,9 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndCreateNewPlaylistOnlyAfterValidName)
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -520,6 +524,8 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndRemoveOneSong) {
 ║      │▶ ..                          ││  Crazy frog.mp3              │      ║
 ║      │  audio_lyric_finder.cc       ││  Crazy love.mp3              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -531,11 +537,9 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndRemoveOneSong) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -572,7 +576,8 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndRemoveOneSong) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::SavePlaylistsToFile),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::Playlist>(expected_playlist)))));
+                                    VariantWith<SharedContent<model::Playlist>>(
+                                        Pointee(expected_playlist))))));
 
   dialog->OnEvent(ftxui::Event::Character('s'));
 
@@ -592,6 +597,8 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndRemoveOneSong) {
 ║      │▶ ..                          ││  Crazy frog.mp3              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -603,11 +610,9 @@ TEST_F(PlaylistDialogTest, CancelRenamingAndRemoveOneSong) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -641,7 +646,7 @@ TEST_F(PlaylistDialogTest, AddThenRemoveSongFromExistentPlaylist) {
   EXPECT_CALL(contains_audio_cb, Call).WillOnce(Return(true));
 
   // Add random file, focus playlist menu and remove new entry
-  std::string typed{"jjj ljjj "};
+  std::string typed{"jjjjj ljjj "};
   utils::QueueCharacterEvents(*dialog, typed);
 
   dialog->OnEvent(ftxui::Event::Escape);
@@ -659,6 +664,8 @@ TEST_F(PlaylistDialogTest, AddThenRemoveSongFromExistentPlaylist) {
 ║      │  ..                          ││  Crazy frog.mp3              │      ║
 ║      │  audio_lyric_finder.cc       ││▶ Crazy love.mp3              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │▶ block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -670,11 +677,9 @@ TEST_F(PlaylistDialogTest, AddThenRemoveSongFromExistentPlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -737,6 +742,8 @@ TEST_F(PlaylistDialogTest, RenameExistentPlaylist) {
 ║      │▶ ..                          ││  Reggae wubba dubba.mp3      │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -748,11 +755,9 @@ TEST_F(PlaylistDialogTest, RenameExistentPlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -773,7 +778,8 @@ TEST_F(PlaylistDialogTest, RenameExistentPlaylist) {
               SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                     interface::CustomEvent::Identifier::SavePlaylistsToFile),
                               Field(&interface::CustomEvent::content,
-                                    VariantWith<model::Playlist>(expected_playlist)))));
+                                    VariantWith<SharedContent<model::Playlist>>(
+                                        Pointee(expected_playlist))))));
 
   // Make an attempt to save playlist, but this should not work
   dialog->OnEvent(ftxui::Event::Character('s'));
@@ -791,7 +797,7 @@ TEST_F(PlaylistDialogTest, AttemptToCreateEmptyPlaylist) {
   EXPECT_CALL(contains_audio_cb, Call).WillOnce(Return(false));
 
   // Attempt to add a new entry
-  std::string typed{"jjj "};
+  std::string typed{"jjjjj "};
   utils::QueueCharacterEvents(*dialog, typed);
 
   ftxui::Render(*screen, dialog->Render(size));
@@ -807,6 +813,8 @@ TEST_F(PlaylistDialogTest, AttemptToCreateEmptyPlaylist) {
 ║      │  ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │▶ block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -818,11 +826,9 @@ TEST_F(PlaylistDialogTest, AttemptToCreateEmptyPlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -866,6 +872,8 @@ TEST_F(PlaylistDialogTest, AttemptToCreateEmptyPlaylist) {
 ║      │  ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │▶ block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -877,11 +885,9 @@ TEST_F(PlaylistDialogTest, AttemptToCreateEmptyPlaylist) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -906,7 +912,7 @@ TEST_F(PlaylistDialogTest, RenameWithABiggerName) {
   EXPECT_CALL(contains_audio_cb, Call).WillOnce(Return(true));
 
   // Add a new entry
-  std::string typed{"jjjjj lronceuponatimetherewasanepicplaylist"};
+  std::string typed{"jjjjjjj lronceuponatimetherewasanepicplaylist"};
   utils::QueueCharacterEvents(*dialog, typed);
 
   // Apply new name
@@ -939,6 +945,8 @@ TEST_F(PlaylistDialogTest, RenameWithABiggerName) {
 ║      │  ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │▶ block_media_player.cc       ││                              │      ║
@@ -950,11 +958,9 @@ TEST_F(PlaylistDialogTest, RenameWithABiggerName) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -996,6 +1002,8 @@ TEST_F(PlaylistDialogTest, SendNonEmptyPlaylistWithCreate) {
 ║      │▶ ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -1007,11 +1015,9 @@ TEST_F(PlaylistDialogTest, SendNonEmptyPlaylistWithCreate) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -1047,6 +1053,8 @@ TEST_F(PlaylistDialogTest, SendEmptyPlaylistWithModify) {
 ║      │▶ ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -1058,11 +1066,9 @@ TEST_F(PlaylistDialogTest, SendEmptyPlaylistWithModify) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
@@ -1136,6 +1142,8 @@ TEST_F(PlaylistDialogTest, RemoveLastSongAndSave) {
 ║      │▶ ..                          ││                              │      ║
 ║      │  audio_lyric_finder.cc       ││                              │      ║
 ║      │  audio_player.cc             ││                              │      ║
+║      │  base_render_scheduler.cc    ││                              │      ║
+║      │  base_ticker.cc              ││                              │      ║
 ║      │  block_file_info.cc          ││                              │      ║
 ║      │  block_main_content.cc       ││                              │      ║
 ║      │  block_media_player.cc       ││                              │      ║
@@ -1147,11 +1155,9 @@ TEST_F(PlaylistDialogTest, RemoveLastSongAndSave) {
 ║      │  middleware_media_controller.││                              │      ║
 ║      │  mock                        ││                              │      ║
 ║      │  util_argparser.cc           ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
-║      │                              ││                              │      ║
+║      │  util_file_handler.cc        ││                              │      ║
+║      │  util_library_index.cc       ││                              │      ║
+║      │  util_search_index.cc        ││                              │      ║
 ║      │                              ││                              │      ║
 ║      │                              ││                              │      ║
 ║      ╰──────────────────────────────╯╰──────────────────────────────╯      ║
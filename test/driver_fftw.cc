@@ -3,59 +3,129 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#ifndef SPECTRUM_BUILTIN_FFT
+#include <fftw3.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+#include "audio/driver/builtin_fft.h"
+#ifndef SPECTRUM_BUILTIN_FFT
 #include "audio/driver/fftw.h"
+#endif
+#include "audio/driver/internal/fft.h"
+#include "audio/driver/internal/magnitude.h"
 #include "util/logger.h"
 
 namespace {
 
+using ::testing::DoubleNear;
 using ::testing::ElementsAreArray;
 using ::testing::Matcher;
 
+static constexpr int kNumberBars = 10;    //!< Number of bars per channel
+static constexpr int kBufferSize = 1024;  //!< Input buffer size
+
+#ifdef SPECTRUM_FFTW_FLOAT
+//! Automatic sensitivity is adjusted in steps of 2%, so single precision may end in another step
+static constexpr double kTolerance = 0.02;
+#else
+static constexpr double kTolerance = 0;  //!< Double precision must match exactly
+#endif
+
 /**
- * @brief Tests with FFTW class
+ * @brief Tests with audio analysis, running the same tests for every FFT backend available
  */
-class FftwTest : public ::testing::Test {
-  // using-declarations
-  using Fftw = std::unique_ptr<driver::FFTW>;
-
+template <typename T>
+class AnalyzerTest : public ::testing::Test {
  protected:
-  static void SetUpTestSuite() { util::Logger::GetInstance().Configure(); }
+  static void SetUpTestSuite() {
+    util::Logger::GetInstance().Configure();
+
+    // Never use wisdom from the real cache (or from previous executions)
+    std::filesystem::remove_all(GetWisdomPath().parent_path());
+  }
+
+  static void TearDownTestSuite() { std::filesystem::remove_all(GetWisdomPath().parent_path()); }
 
   void SetUp() override { Init(); }
 
   void TearDown() override { analyzer.reset(); }
 
   void Init() {
-    analyzer = std::make_unique<driver::FFTW>();
+    analyzer = Create();
     analyzer->Init(kNumberBars * 2);
   }
 
+  //! Create analyzer for the FFT backend under test (FFTW caches its wisdom in a temporary file)
+  static std::unique_ptr<T> Create() {
+    if constexpr (std::is_constructible_v<T, std::string>) {
+      return std::make_unique<T>(GetWisdomPath().string());
+    } else {
+      return std::make_unique<T>();
+    }
+  }
+
+  //! Get full path to FFTW wisdom file used by tests
+  static std::filesystem::path GetWisdomPath() {
+    return std::filesystem::temp_directory_path() / "spectrum_test_fftw" / "fftw.wisdom";
+  }
+
+  //! Get transforms from analyzer (to check if they are reused)
+  std::vector<const void*> GetPlans() const {
+    return {analyzer->bass_.plan.get(), analyzer->mid_.plan.get(), analyzer->treble_.plan.get()};
+  }
+
+  //! Get decimated input used by bass analysis (from oldest to newest sample)
+  static std::vector<double> GetDecimated(const T& other) {
+    auto first = other.decimated_.begin() + other.decimated_head_;
+    return {first, first + other.decimated_size_};
+  }
+
   // TODO: implement (get block starting on line :78)
-  void PrintResults(const std::vector<double>& result) {}
+  void PrintResults(const model::AudioSpectrum& result) {}
 
  protected:
-  static constexpr int kNumberBars = 10;    //!< Number of bars per channel
-  static constexpr int kBufferSize = 1024;  //!< Input buffer size
-
-  Fftw analyzer;  //!< Audio frequency analysis
+  std::unique_ptr<T> analyzer;  //!< Audio frequency analysis
 };
 
+#ifdef SPECTRUM_BUILTIN_FFT
+using Backends = ::testing::Types<driver::BuiltinFft>;
+#else
+using Backends = ::testing::Types<driver::FFTW, driver::BuiltinFft>;
+
+//! Tests only for FFTW backend
+using FftwTest = AnalyzerTest<driver::FFTW>;
+#endif
+
+TYPED_TEST_SUITE(AnalyzerTest, Backends);
+
 /* ********************************************************************************************** */
 
-TEST_F(FftwTest, InitAndExecute) {
+TYPED_TEST(AnalyzerTest, InitAndExecute) {
   // Create expected results
-  const Matcher<double> expected_200MHz[kNumberBars] = {0, 0, 0.999, 0.009, 0, 0.001, 0, 0, 0, 0};
-  const Matcher<double> expected_2000MHz[kNumberBars] = {0, 0, 0, 0, 0, 0, 0.524, 0.474, 0, 0};
+  const double result_200MHz[kNumberBars] = {0, 0, 0.999, 0.009, 0, 0.001, 0, 0, 0, 0};
+  const double result_2000MHz[kNumberBars] = {0, 0, 0, 0, 0, 0, 0.524, 0.474, 0, 0};
+
+  std::vector<Matcher<double>> expected_200MHz, expected_2000MHz;
+  for (int i = 0; i < kNumberBars; i++) {
+    expected_200MHz.push_back(DoubleNear(result_200MHz[i], kTolerance));
+    expected_2000MHz.push_back(DoubleNear(result_2000MHz[i], kTolerance));
+  }
 
   // Create in/out buffers
-  int out_size = analyzer->GetOutputSize();
-  std::vector<double> out(out_size, 0);
-  std::vector<double> in(kBufferSize, 0);
+  int out_size = this->analyzer->GetOutputSize();
+  model::AudioSpectrum out(out_size, 0);
+  std::vector<model::Sample> in(kBufferSize, 0);
 
   // Running execute 300 times (simulating about 3.5 seconds run time
   for (int k = 0; k < 300; k++) {
@@ -66,17 +136,18 @@ TEST_F(FftwTest, InitAndExecute) {
       in[n * 2 + 1] = sin(2 * M_PI * 2000 / 44100 * (n + ((float)k * kBufferSize / 2))) * 20000;
     }
 
-    analyzer->Execute(in.data(), kBufferSize, out.data());
+    this->analyzer->Execute(in.data(), kBufferSize, out.data());
   }
 
-  // Rounding last output to nearest 1/1000th
+  // Rounding last output to nearest 1/1000th (in double precision, to compare with expectation)
+  std::vector<double> rounded(out_size, 0);
   for (int i = 0; i < out_size; i++) {
-    out[i] = (double)round(out[i] * 1000) / 1000;
+    rounded[i] = (double)round(out[i] * 1000) / 1000;
   }
 
   // Split result by channel
-  std::vector<double> left(out.begin(), out.begin() + 10);
-  std::vector<double> right(out.begin() + 10, out.begin() + 20);
+  std::vector<double> left(rounded.begin(), rounded.begin() + 10);
+  std::vector<double> right(rounded.begin() + 10, rounded.begin() + 20);
 
   // Print results
   std::cout.setf(std::ios::fixed, std::ios::floatfield);
@@ -97,4 +168,424 @@ TEST_F(FftwTest, InitAndExecute) {
   ASSERT_THAT(right, ElementsAreArray(expected_2000MHz));
 }
 
+/* ********************************************************************************************** */
+
+TYPED_TEST(AnalyzerTest, ExecuteWithUnevenInputSizes) {
+  // Chunk sizes that do not divide the internal buffer, so input will wrap around in the middle
+  const int chunk_sizes[] = {1000, 1048, 600, 1446, 2};
+
+  int out_size = this->analyzer->GetOutputSize();
+  model::AudioSpectrum out(out_size, 0);
+  std::vector<model::Sample> in(kBufferSize * 2, 0);
+
+  // Same sinus waves from InitAndExecute: 200MHz in left channel, 2000MHz in right
+  int frame = 0;
+  for (int k = 0; k < 300; k++) {
+    int size = chunk_sizes[k % 5];
+
+    for (int n = 0; n < size / 2; n++, frame++) {
+      in[n * 2] = sin(2 * M_PI * 200 / 44100 * frame) * 20000;
+      in[n * 2 + 1] = sin(2 * M_PI * 2000 / 44100 * frame) * 20000;
+    }
+
+    this->analyzer->Execute(in.data(), size, out.data());
+  }
+
+  // Highest bar must be the same from InitAndExecute
+  auto left_max = std::max_element(out.begin(), out.begin() + kNumberBars);
+  auto right_max = std::max_element(out.begin() + kNumberBars, out.end());
+
+  EXPECT_EQ(std::distance(out.begin(), left_max), 2);
+  EXPECT_EQ(std::distance(out.begin() + kNumberBars, right_max), 6);
+}
+
+/* ********************************************************************************************** */
+
+TYPED_TEST(AnalyzerTest, DecimatedBassWithoutAliasing) {
+  int out_size = this->analyzer->GetOutputSize();
+  model::AudioSpectrum out(out_size, 0);
+  std::vector<model::Sample> in(kBufferSize, 0);
+
+  // 60MHz in left channel (bass), and in right channel, a frequency that would be aliased into the
+  // same bass range after decimation (if input was not filtered before downsampling)
+  for (int k = 0; k < 300; k++) {
+    for (int n = 0; n < kBufferSize / 2; n++) {
+      in[n * 2] = sin(2 * M_PI * 60 / 44100 * (n + ((float)k * kBufferSize / 2))) * 20000;
+      in[n * 2 + 1] = sin(2 * M_PI * 5452 / 44100 * (n + ((float)k * kBufferSize / 2))) * 20000;
+    }
+
+    this->analyzer->Execute(in.data(), kBufferSize, out.data());
+  }
+
+  // Bass tone must be found in the first bar from left channel
+  auto left_max = std::max_element(out.begin(), out.begin() + kNumberBars);
+  EXPECT_EQ(std::distance(out.begin(), left_max), 0);
+
+  // And right channel must not contain anything in the bass range
+  EXPECT_LT(out[kNumberBars], 0.01);
+  EXPECT_LT(out[kNumberBars + 1], 0.01);
+}
+
+/* ********************************************************************************************** */
+
+TYPED_TEST(AnalyzerTest, ExecuteWithWholeBuffer) {
+  const int size = this->analyzer->GetBufferSize();
+
+  // Another analyzer receives the same input, but in smaller chunks
+  auto chunked = TestFixture::Create();
+  chunked->Init(kNumberBars * 2);
+
+  model::AudioSpectrum out(kNumberBars * 2, 0);
+  std::vector<model::Sample> in(size, 0);
+
+  // Bass tone in left channel and a higher tone in right channel
+  int frame = 0;
+  for (int k = 0; k < 5; k++) {
+    for (int n = 0; n < size / 2; n++, frame++) {
+      in[n * 2] = sin(2 * M_PI * 60 / 44100 * frame) * 20000;
+      in[n * 2 + 1] = sin(2 * M_PI * 3000 / 44100 * frame) * 20000;
+    }
+
+    EXPECT_EQ(this->analyzer->Execute(in.data(), size, out.data()), error::kSuccess);
+
+    for (int offset = 0; offset < size; offset += kBufferSize) {
+      chunked->Execute(in.data() + offset, kBufferSize, out.data());
+    }
+  }
+
+  // Decimation filter must only use real history, so input split does not change its output
+  auto expected = TestFixture::GetDecimated(*chunked);
+  std::vector<Matcher<double>> matchers;
+  for (const auto& value : expected) matchers.push_back(DoubleNear(value, 1e-3));
+
+  EXPECT_THAT(TestFixture::GetDecimated(*this->analyzer), ElementsAreArray(matchers));
+}
+
+/* ********************************************************************************************** */
+
+TEST(FftwKernelTest, SumMagnitudes) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+
+  // Enough values to use SIMD, plus some remaining values for the scalar fallback
+  std::vector<model::Sample> data(2 * 64);
+  for (auto& value : data) value = distribution(generator);
+
+  for (int count = 0; count <= 64; count++) {
+    // Reference implementation with the same calculation previously used by FFTW
+    double expected = 0;
+    for (int i = 0; i < count; i++) expected += hypot(data[i * 2], data[i * 2 + 1]);
+
+    double tolerance = std::max(expected * 1e-5, 1e-9);
+
+    EXPECT_NEAR(driver::internal::SumMagnitudes(data.data(), count), expected, tolerance);
+    EXPECT_NEAR(driver::internal::SumMagnitudesScalar(data.data(), count), expected, tolerance);
+  }
+}
+
+/* ********************************************************************************************** */
+
+/**
+ * @brief Compare built-in FFT against a direct DFT calculation (only some bins, to run it fast)
+ */
+template <int N>
+void ExpectRealFftMatchesDft() {
+  using Transform = driver::internal::fft::RealFft<model::Sample, N>;
+
+  std::mt19937 generator(N);
+  std::uniform_real_distribution<double> distribution(-20000, 20000);
+
+  std::vector<model::Sample> in(N);
+  std::vector<model::Sample> out(Transform::kOutputSize * 2);
+  std::vector<model::Sample> scratch(Transform::kScratchSize);
+
+  for (auto& value : in) value = distribution(generator);
+
+  Transform::Forward(in.data(), out.data(), scratch.data());
+
+  // Rounding error is proportional to input magnitude
+  double total = 0;
+  for (const auto& value : in) total += std::abs(value);
+
+#ifdef SPECTRUM_FFTW_FLOAT
+  double tolerance = total * 1e-5;
+#else
+  double tolerance = total * 1e-12;
+#endif
+
+  for (int k = 0; k < Transform::kOutputSize; k += 31) {
+    double real = 0;
+    double imag = 0;
+
+    for (int n = 0; n < N; n++) {
+      double angle = 2 * M_PI * (double)k * n / N;
+      real += in[n] * cos(angle);
+      imag -= in[n] * sin(angle);
+    }
+
+    EXPECT_NEAR(out[k * 2], real, tolerance) << "size=" << N << " bin=" << k;
+    EXPECT_NEAR(out[k * 2 + 1], imag, tolerance) << "size=" << N << " bin=" << k;
+  }
+}
+
+/* ********************************************************************************************** */
+
+TEST(FftwKernelTest, BuiltinRealFft) {
+  ExpectRealFftMatchesDft<1024>();
+  ExpectRealFftMatchesDft<4096>();
+  ExpectRealFftMatchesDft<8192>();
+}
+
+/* ********************************************************************************************** */
+
+TEST(FftwKernelTest, BuiltinPlanWithBothChannels) {
+  namespace fft = driver::internal::fft;
+  constexpr int kSize = 1024;
+  constexpr int kOutputSize = kSize / 2 + 1;
+
+  std::unique_ptr<model::Sample, decltype(&fft::Free)> in(fft::AllocReal(kSize * 2), &fft::Free);
+  std::unique_ptr<fft::Complex, decltype(&fft::Free)> out(fft::AllocComplex(kOutputSize * 2),
+                                                          &fft::Free);
+
+  // Unsupported transform size
+  int invalid = 1000;
+  EXPECT_EQ(fft::PlanManyDftR2C(1, &invalid, 2, in.get(), nullptr, 1, invalid, out.get(), nullptr,
+                                1, kOutputSize, 0),
+            nullptr);
+
+  int size = kSize;
+  fft::Plan* plan = fft::PlanManyDftR2C(1, &size, 2, in.get(), nullptr, 1, kSize, out.get(),
+                                        nullptr, 1, kOutputSize, 0);
+  ASSERT_NE(plan, nullptr);
+
+  // Different sinus waves per channel: 8 cycles in left channel and 100 cycles in right
+  for (int n = 0; n < kSize; n++) {
+    in.get()[n] = sin(2 * M_PI * 8 * n / kSize);
+    in.get()[n + kSize] = sin(2 * M_PI * 100 * n / kSize);
+  }
+
+  fft::Execute(plan);
+  fft::DestroyPlan(plan);
+
+  // Each channel must have its peak at the expected bin
+  auto magnitude = [&out](int index) { return hypot(out.get()[index][0], out.get()[index][1]); };
+
+  auto argmax = [&magnitude](int first) {
+    int max_index = first;
+    for (int i = first; i < first + kOutputSize; i++) {
+      if (magnitude(i) > magnitude(max_index)) max_index = i;
+    }
+    return max_index - first;
+  };
+
+  EXPECT_EQ(argmax(0), 8);
+  EXPECT_EQ(argmax(kOutputSize), 100);
+  EXPECT_NEAR(magnitude(8), kSize / 2, 1e-2);
+}
+
+/* ********************************************************************************************** */
+
+#ifndef SPECTRUM_BUILTIN_FFT
+
+/**
+ * @brief Measure average time to run a single transform with built-in FFT and FFTW
+ */
+template <int N>
+void BenchmarkAgainstFftw(int iterations) {
+  using Transform = driver::internal::fft::RealFft<model::Sample, N>;
+  using Clock = std::chrono::steady_clock;
+
+#ifdef SPECTRUM_FFTW_FLOAT
+  auto* in = fftwf_alloc_real(N);
+  auto* out = fftwf_alloc_complex(N / 2 + 1);
+  auto plan = fftwf_plan_dft_r2c_1d(N, in, out, FFTW_MEASURE);
+#else
+  auto* in = fftw_alloc_real(N);
+  auto* out = fftw_alloc_complex(N / 2 + 1);
+  auto plan = fftw_plan_dft_r2c_1d(N, in, out, FFTW_MEASURE);
+#endif
+
+  std::vector<model::Sample> builtin_out(Transform::kOutputSize * 2);
+  std::vector<model::Sample> scratch(Transform::kScratchSize);
+
+  std::mt19937 generator(N);
+  std::uniform_real_distribution<double> distribution(-20000, 20000);
+  for (int n = 0; n < N; n++) in[n] = distribution(generator);
+
+  auto start = Clock::now();
+  for (int i = 0; i < iterations; i++) Transform::Forward(in, builtin_out.data(), scratch.data());
+  auto builtin = Clock::now() - start;
+
+  start = Clock::now();
+#ifdef SPECTRUM_FFTW_FLOAT
+  for (int i = 0; i < iterations; i++) fftwf_execute(plan);
+#else
+  for (int i = 0; i < iterations; i++) fftw_execute(plan);
+#endif
+  auto fftw = Clock::now() - start;
+
+  auto per_transform = [iterations](Clock::duration elapsed) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations;
+  };
+
+  std::cout << "size=" << N << " builtin=" << per_transform(builtin)
+            << "ns fftw=" << per_transform(fftw) << "ns\n";
+
+  // Results must be close to each other
+  for (int k = 0; k < N / 2 + 1; k++) {
+    EXPECT_NEAR(builtin_out[k * 2], out[k][0], std::abs(out[k][0]) * 1e-3 + 1);
+    EXPECT_NEAR(builtin_out[k * 2 + 1], out[k][1], std::abs(out[k][1]) * 1e-3 + 1);
+  }
+
+#ifdef SPECTRUM_FFTW_FLOAT
+  fftwf_destroy_plan(plan);
+  fftwf_free(out);
+  fftwf_free(in);
+#else
+  fftw_destroy_plan(plan);
+  fftw_free(out);
+  fftw_free(in);
+#endif
+}
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(FftwKernelTest, DISABLED_BenchmarkBuiltinAgainstFftw) {
+  BenchmarkAgainstFftw<1024>(20000);
+  BenchmarkAgainstFftw<4096>(5000);
+  BenchmarkAgainstFftw<8192>(2500);
+}
+
+#endif
+
+/* ********************************************************************************************** */
+
+TYPED_TEST(AnalyzerTest, ReusePlansAcrossInit) {
+  auto plans = this->GetPlans();
+
+  std::vector<model::Sample> in(kBufferSize, 1);
+  model::AudioSpectrum out(kNumberBars * 4, 0);
+
+  // Resize output a few times, running analysis in between
+  for (int size : {kNumberBars * 4, kNumberBars * 2, kNumberBars * 4}) {
+    this->analyzer->Init(size);
+    this->analyzer->Execute(in.data(), kBufferSize, out.data());
+
+    EXPECT_EQ(this->analyzer->GetOutputSize(), size);
+    EXPECT_EQ(this->GetPlans(), plans);
+  }
+}
+
+/* ********************************************************************************************** */
+
+#ifndef SPECTRUM_BUILTIN_FFT
+
+TEST_F(FftwTest, SaveAndLoadWisdom) {
+  // Analyzer created by fixture already saved its wisdom to file
+  ASSERT_TRUE(std::filesystem::exists(GetWisdomPath()));
+  EXPECT_GE(analyzer->GetPlanStatistics().elapsed.count(), 0);
+
+  // So a new analyzer must load it, instead of measuring plans again
+  driver::FFTW other{GetWisdomPath().string()};
+  other.Init(kNumberBars * 2);
+
+  auto statistics = other.GetPlanStatistics();
+  EXPECT_TRUE(statistics.imported);
+  EXPECT_FALSE(statistics.measured);
+
+  // And analysis results must be the same from the existing analyzer
+  std::vector<model::Sample> in(kBufferSize, 0);
+  model::AudioSpectrum out(kNumberBars * 2, 0), other_out(kNumberBars * 2, 0);
+
+  for (int k = 0; k < 10; k++) {
+    for (int n = 0; n < kBufferSize; n++) {
+      in[n] = sin(2 * M_PI * 440 / 44100 * (n / 2 + k * kBufferSize / 2)) * 20000;
+    }
+
+    analyzer->Execute(in.data(), kBufferSize, out.data());
+    other.Execute(in.data(), kBufferSize, other_out.data());
+  }
+
+  EXPECT_THAT(other_out, ElementsAreArray(out));
+}
+
+/* ********************************************************************************************** */
+
+TEST_F(FftwTest, SameResultsFromBuiltinFft) {
+  driver::BuiltinFft builtin;
+  builtin.Init(kNumberBars * 2);
+
+  std::vector<model::Sample> in(kBufferSize, 0);
+  model::AudioSpectrum out(kNumberBars * 2, 0), builtin_out(kNumberBars * 2, 0);
+
+  // Same sinus waves from InitAndExecute: 200MHz in left channel, 2000MHz in right
+  for (int k = 0; k < 100; k++) {
+    for (int n = 0; n < kBufferSize / 2; n++) {
+      in[n * 2] = sin(2 * M_PI * 200 / 44100 * (n + ((float)k * kBufferSize / 2))) * 20000;
+      in[n * 2 + 1] = sin(2 * M_PI * 2000 / 44100 * (n + ((float)k * kBufferSize / 2))) * 20000;
+    }
+
+    analyzer->Execute(in.data(), kBufferSize, out.data());
+    builtin.Execute(in.data(), kBufferSize, builtin_out.data());
+  }
+
+  // Both backends must be interchangeable (only rounding errors from FFT are expected)
+  std::vector<Matcher<double>> expected;
+  for (const auto& value : out) expected.push_back(DoubleNear(value, kTolerance + 1e-3));
+
+  EXPECT_THAT(std::vector<double>(builtin_out.begin(), builtin_out.end()),
+              ElementsAreArray(expected));
+}
+
+#endif
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TYPED_TEST(AnalyzerTest, DISABLED_BenchmarkExecute) {
+  using Clock = std::chrono::steady_clock;
+
+  // Same chunk size sent by media controller when running analysis at 30 fps
+  constexpr int kChunkSize = 44100 * 2 / 30 & ~1;
+  constexpr int kIterations = 5000;
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(-20000, 20000);
+
+  std::vector<model::Sample> in(kChunkSize);
+  for (auto& value : in) value = distribution(generator);
+
+  model::AudioSpectrum out(this->analyzer->GetOutputSize(), 0);
+
+  // Warm up caches before measuring it
+  for (int i = 0; i < 100; i++) this->analyzer->Execute(in.data(), kChunkSize, out.data());
+
+  auto start = Clock::now();
+  for (int i = 0; i < kIterations; i++) this->analyzer->Execute(in.data(), kChunkSize, out.data());
+  auto elapsed = Clock::now() - start;
+
+  std::cout << "chunk=" << kChunkSize << " execute="
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / kIterations
+            << "ns\n";
+}
+
+/* ********************************************************************************************** */
+
+TYPED_TEST(AnalyzerTest, ResizeWhileExecuting) {
+  std::vector<model::Sample> in(kBufferSize, 1);
+  model::AudioSpectrum out(kNumberBars * 4, 0);
+
+  // Request new output size, it should only be applied by the end of next execution
+  this->analyzer->Init(kNumberBars * 4);
+  EXPECT_EQ(this->analyzer->GetOutputSize(), kNumberBars * 2);
+
+  this->analyzer->Execute(in.data(), kBufferSize, out.data());
+  EXPECT_EQ(this->analyzer->GetOutputSize(), kNumberBars * 4);
+
+  // And now, run again with the new state
+  EXPECT_EQ(this->analyzer->Execute(in.data(), kBufferSize, out.data()), error::kSuccess);
+  EXPECT_EQ(this->analyzer->GetOutputSize(), kNumberBars * 4);
+}
+
 }  // namespace
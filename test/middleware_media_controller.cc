@@ -4,6 +4,7 @@
 #include <gtest/gtest-test-part.h>
 
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "audio/base/notifier.h"
@@ -27,11 +28,27 @@ using ::testing::Eq;
 using ::testing::Field;
 using ::testing::InSequence;
 using ::testing::Invoke;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::VariantWith;
 
+template <typename T>
+using SharedContent = interface::CustomEvent::Shared<T>;
+
 using testing::TestSyncer;
 
+/**
+ * @brief Match content from DrawAudioSpectrum event, by reading the most recent frame published
+ * into shared spectrum frames (the same way that spectrum visualizer does it)
+ */
+MATCHER_P(SpectrumFrameWith, matcher, "") {
+  auto frames = arg.template GetContent<std::shared_ptr<model::SharedSpectrum>>();
+  if (!frames) return false;
+
+  frames->Update();
+  return ExplainMatchResult(matcher, frames->GetFrontBuffer(), result_listener);
+}
+
 /**
  * @brief Tests with MediaController class
  */
@@ -122,6 +139,31 @@ TEST_F(MediaControllerTestThread, CreateDummyController) {
 
 /* ********************************************************************************************** */
 
+TEST_F(MediaControllerTestThread, ResizeAnalysisOutputOnWorker) {
+  auto resize = [&](TestSyncer& syncer) {
+    auto analyzer = GetAnalyzer();
+    int number_bars = 32;
+
+    // Resize must be executed by the resize thread, without blocking the caller
+    EXPECT_CALL(*analyzer, Init(Eq(number_bars))).WillOnce(Invoke([&](int) {
+      syncer.NotifyStep(1);
+      return error::kSuccess;
+    }));
+
+    GetPlayerNotifier()->ResizeAnalysisOutput(number_bars);
+  };
+
+  auto client = [&](TestSyncer& syncer) {
+    // Wait for resize to finish before exiting from controller
+    syncer.WaitForStep(1);
+    controller->Exit();
+  };
+
+  testing::RunAsyncTest({resize, client});
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(MediaControllerTest, ExecuteAllMethodsFromAudioNotifier) {
   using ::testing::TypedEq;
   auto notifier = GetPlayerNotifier();
@@ -159,11 +201,12 @@ TEST_F(MediaControllerTest, ExecuteAllMethodsFromAudioNotifier) {
   EXPECT_CALL(*audio_ctl, ApplyAudioFilters(preset));
   notifier->ApplyAudioFilters(preset);
 
-  model::Playlist playlist = model::Playlist{
+  // Playlist must be forwarded as it is (without copying it)
+  auto playlist = std::make_shared<const model::Playlist>(model::Playlist{
       .name = "Summer Eletrohits Vol. 1",
       .songs = {model::Song{.artist = "Kasino", .title = "Can't get over"}},
-  };
-  EXPECT_CALL(*audio_ctl, Play(TypedEq<const model::Playlist&>(playlist)));
+  });
+  EXPECT_CALL(*audio_ctl, Play(TypedEq<const model::SharedPlaylist&>(playlist)));
   notifier->NotifyPlaylistSelection(playlist);
 }
 
@@ -194,7 +237,8 @@ TEST_F(MediaControllerTest, ExecuteAllMethodsFromInterfaceNotifier) {
       *dispatcher,
       SendEvent(AllOf(
           Field(&interface::CustomEvent::id, interface::CustomEvent::Identifier::UpdateSongInfo),
-          Field(&interface::CustomEvent::content, VariantWith<model::Song>(audio)))));
+          Field(&interface::CustomEvent::content,
+                VariantWith<SharedContent<model::Song>>(Pointee(audio))))));
   notifier->NotifySongInformation(audio);
 
   model::Song::CurrentInformation info{.state = model::Song::MediaState::Play, .position = 0};
@@ -230,16 +274,15 @@ TEST_F(MediaControllerTest, AnalysisOnRawAudio) {
 
     // Thread received a new command, create expectation to analyze and send its result back to UI
     EXPECT_CALL(*analyzer, Execute(_, Eq(sample_size), _))
-        .WillOnce(Invoke([&](double*, int, double*) {
+        .WillOnce(Invoke([&](model::Sample*, int, model::Sample*) {
           syncer.NotifyStep(2);
           return error::kSuccess;
         }));
 
     EXPECT_CALL(*dispatcher,
-                SendEvent(AllOf(
-                    Field(&interface::CustomEvent::id,
-                          interface::CustomEvent::Identifier::DrawAudioSpectrum),
-                    Field(&interface::CustomEvent::content, VariantWith<std::vector<double>>(_)))));
+                SendEvent(AllOf(Field(&interface::CustomEvent::id,
+                                      interface::CustomEvent::Identifier::DrawAudioSpectrum),
+                                SpectrumFrameWith(_))));
 
     // Notify that expectations are set, and run audio loop
     syncer.NotifyStep(1);
@@ -264,6 +307,59 @@ TEST_F(MediaControllerTest, AnalysisOnRawAudio) {
 
 /* ********************************************************************************************** */
 
+TEST_F(MediaControllerTest, AnalysisDiscardsLateAudio) {
+  int sample_size = 16;
+  model::Sample first_sample = -1;
+
+  auto analysis = [&](TestSyncer& syncer) {
+    auto analyzer = GetAnalyzer();
+    auto dispatcher = GetEventDispatcher();
+
+    EXPECT_CALL(*analyzer, GetBufferSize()).WillRepeatedly(Return(sample_size));
+    EXPECT_CALL(*analyzer, GetOutputSize()).WillRepeatedly(Return(kNumberBars));
+
+    // Each frame must consume at most the analyzer buffer size, and only the most recent audio data
+    EXPECT_CALL(*analyzer, Execute(_, Eq(sample_size), _))
+        .WillRepeatedly(Invoke([&](model::Sample* input, int, model::Sample*) {
+          if (first_sample < 0) {
+            first_sample = input[0];
+            syncer.NotifyStep(2);
+          }
+          return error::kSuccess;
+        }));
+
+    EXPECT_CALL(*dispatcher,
+                SendEvent(Field(&interface::CustomEvent::id,
+                                interface::CustomEvent::Identifier::DrawAudioSpectrum)))
+        .Times(::testing::AtLeast(1));
+
+    // Notify that expectations are set, and run audio loop
+    syncer.NotifyStep(1);
+    RunAnalysisLoop();
+  };
+
+  auto client = [&](TestSyncer& syncer) {
+    auto notifier = GetInterfaceNotifier();
+
+    // Send much more data than what would be consumed by a few frames
+    syncer.WaitForStep(1);
+    std::vector<int> buffer(sample_size * 10);
+    std::iota(buffer.begin(), buffer.end(), 0);
+    notifier->SendAudioRaw(buffer.data(), buffer.size());
+
+    // Wait for Analysis to run at least once before exiting from controller
+    syncer.WaitForStep(2);
+    controller->Exit();
+  };
+
+  testing::RunAsyncTest({analysis, client});
+
+  // Only the latest frames are kept for analysis (4 frames of 16 samples)
+  EXPECT_EQ(first_sample, sample_size * 6);
+}
+
+/* ********************************************************************************************** */
+
 TEST_F(MediaControllerTest, AnalysisAndClearAnimation) {
   int sample_size = 16;
 
@@ -279,7 +375,7 @@ TEST_F(MediaControllerTest, AnalysisAndClearAnimation) {
     EXPECT_CALL(*analyzer, GetBufferSize()).WillRepeatedly(Return(sample_size));
     EXPECT_CALL(*analyzer, GetOutputSize()).WillRepeatedly(Return(kNumberBars));
 
-    std::vector<double> result(kNumberBars, 1);
+    model::AudioSpectrum result(kNumberBars, 1);
 
     {
       // To better readability, split into two scopes to treat each thread command separately
@@ -287,7 +383,7 @@ TEST_F(MediaControllerTest, AnalysisAndClearAnimation) {
 
       // Create expectation to analyze data and send its result back to UI
       EXPECT_CALL(*analyzer, Execute(_, Eq(sample_size), _))
-          .WillOnce(Invoke([&](double* input, int size, double* output) {
+          .WillOnce(Invoke([&](model::Sample* input, int size, model::Sample* output) {
             // Just copy input to output
             std::copy(input, input + kNumberBars, output);
             syncer.NotifyStep(2);
@@ -298,8 +394,7 @@ TEST_F(MediaControllerTest, AnalysisAndClearAnimation) {
           *dispatcher,
           SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                 interface::CustomEvent::Identifier::DrawAudioSpectrum),
-                          Field(&interface::CustomEvent::content,
-                                VariantWith<std::vector<double>>(ElementsAreArray(result))))))
+                          SpectrumFrameWith(ElementsAreArray(result)))))
           .WillOnce(Invoke([&](const interface::CustomEvent&) { syncer.NotifyStep(2); }));
     }
 
@@ -311,32 +406,16 @@ TEST_F(MediaControllerTest, AnalysisAndClearAnimation) {
                                   Field(&interface::CustomEvent::content,
                                         VariantWith<model::Song::CurrentInformation>(info)))));
 
-      // This sequence is placed after UpdateSongState event because this specific event is fired
+      // This expectation is set after UpdateSongState event because this specific event is fired
       // from Player thread and not from Analysis thread (in the "real life")
-      InSequence seq;
-
-      // As we can get a lot of DrawAudioSpectrum events, calculate result and create expectations
-      // Each loop will reduce its previous value by 35%
-      for (int i = 0; i < 10; i++) {
-        std::transform(result.begin(), result.end(), result.begin(),
-                       std::bind(std::multiplies<double>(), std::placeholders::_1, 0.35));
-
-        EXPECT_CALL(
-            *dispatcher,
-            SendEvent(AllOf(Field(&interface::CustomEvent::id,
-                                  interface::CustomEvent::Identifier::DrawAudioSpectrum),
-                            Field(&interface::CustomEvent::content,
-                                  VariantWith<std::vector<double>>(ElementsAreArray(result))))));
-      }
-
-      // Last update from thread with zeroed values for UI
-      std::vector<double> last_update(kNumberBars, 0.001);
+      // P.S.: Spectrum visualizer animates bars on its own, so a single update with zeroed values
+      // is sent to UI
+      model::AudioSpectrum last_update(kNumberBars, 0.001);
       EXPECT_CALL(
           *dispatcher,
           SendEvent(AllOf(Field(&interface::CustomEvent::id,
                                 interface::CustomEvent::Identifier::DrawAudioSpectrum),
-                          Field(&interface::CustomEvent::content,
-                                VariantWith<std::vector<double>>(ElementsAreArray(last_update))))))
+                          SpectrumFrameWith(ElementsAreArray(last_update)))))
           .WillOnce(Invoke([&]() { syncer.NotifyStep(3); }));
     }
 
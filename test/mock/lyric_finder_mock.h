@@ -8,13 +8,16 @@
 
 #include <gmock/gmock-function-mocker.h>
 
+#include <atomic>
+
 #include "audio/lyric/lyric_finder.h"
 
 namespace {
 
 class LyricFinderMock final : public lyric::LyricFinder {
  public:
-  MOCK_METHOD(lyric::SongLyric, Search, (const std::string&, const std::string&), (override));
+  MOCK_METHOD(lyric::SongLyric, Search,
+              (const std::string&, const std::string&, const std::atomic<bool>&), (override));
 };
 
 }  // namespace
@@ -8,13 +8,16 @@
 
 #include <gmock/gmock-function-mocker.h>
 
+#include <atomic>
+
 #include "audio/lyric/base/url_fetcher.h"
 
 namespace {
 
 class UrlFetcherMock final : public driver::UrlFetcher {
  public:
-  MOCK_METHOD(error::Code, Fetch, (const std::string&, std::string&), (override));
+  MOCK_METHOD(error::Code, Fetch, (const std::string&, std::string&, const std::atomic<bool>&),
+              (override));
 };
 
 }  // namespace
@@ -0,0 +1,136 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/file_handler.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(FileSortTest, NaturalOrderIgnoringCaseAndHiddenPrefix) {
+  std::vector<std::string> names{"Track 10.mp3", "track 2.mp3", ".Track 1.mp3", "Track 02b.mp3",
+                                 "Track.mp3",    "album",       "Track 100.mp3"};
+
+  util::Files files;
+  for (const auto& name : names) {
+    files.push_back({.path = name, .sort_key = util::make_sort_key(name)});
+  }
+
+  std::sort(files.begin(), files.end(), util::sort_files);
+
+  std::vector<std::string> sorted;
+  for (const auto& file : files) sorted.push_back(file.path.string());
+
+  EXPECT_THAT(sorted, ElementsAre("album", ".Track 1.mp3", "track 2.mp3", "Track 02b.mp3",
+                                  "Track 10.mp3", "Track 100.mp3", "Track.mp3"));
+}
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(FileSortTest, DISABLED_BenchmarkSortHundredThousandNames) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kFiles = 100000;
+
+  util::Files files;
+  files.reserve(kFiles);
+
+  std::mt19937 generator(42);
+  for (int i = 0; i < kFiles; i++) {
+    std::string name = (generator() % 2 ? "Track " : ".track ") + std::to_string(generator());
+    files.push_back({.path = name + ".mp3"});
+  }
+
+  // Previous approach, normalizing both filenames on every comparison
+  auto legacy = files;
+  auto start = Clock::now();
+  std::sort(legacy.begin(), legacy.end(), [](const util::FileEntry& a, const util::FileEntry& b) {
+    std::string lhs{a.path.filename()};
+    std::string rhs{b.path.filename()};
+
+    if (lhs.at(0) == '.') lhs.erase(0, 1);
+    if (rhs.at(0) == '.') rhs.erase(0, 1);
+
+    std::transform(lhs.begin(), lhs.end(), lhs.begin(), ::tolower);
+    std::transform(rhs.begin(), rhs.end(), rhs.begin(), ::tolower);
+
+    return lhs < rhs;
+  });
+  auto per_comparison = Clock::now() - start;
+
+  // Precompute keys once per entry (as done while listing a directory)
+  start = Clock::now();
+  for (auto& file : files) file.sort_key = util::make_sort_key(file.path);
+  std::sort(files.begin(), files.end(), util::sort_files);
+  auto precomputed = Clock::now() - start;
+
+  auto in_ms = [](Clock::duration elapsed) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  };
+
+  std::cout << "files=" << kFiles << " per_comparison=" << in_ms(per_comparison)
+            << "ms precomputed=" << in_ms(precomputed) << "ms\n";
+
+  EXPECT_TRUE(std::is_sorted(files.begin(), files.end(), util::sort_files));
+  EXPECT_LT(precomputed, per_comparison);
+}
+
+/* ********************************************************************************************** */
+
+TEST(DirectoryWatcherTest, CoalesceBurstOfChanges) {
+  const auto dir_path = std::filesystem::temp_directory_path() / "spectrum_test_watcher";
+  std::filesystem::remove_all(dir_path);
+  std::filesystem::create_directories(dir_path);
+  std::ofstream(dir_path / "old.mp3") << "old";
+
+  util::FileHandler file_handler;
+  std::atomic<int> notifications{0};
+
+  auto watcher = file_handler.WatchDirectory(dir_path, [&notifications] { notifications++; });
+  ASSERT_NE(watcher, nullptr);
+
+  std::set<std::string> expected{"new.mp3"};
+
+  for (int i = 0; i < 100; i++) {
+    std::string name{"track " + std::to_string(i) + ".mp3"};
+    std::ofstream(dir_path / name) << i;
+    if (i != 5) expected.insert(name);
+  }
+
+  std::filesystem::rename(dir_path / "old.mp3", dir_path / "new.mp3");
+  std::filesystem::remove(dir_path / "track 5.mp3");
+
+  // Apply changes the same way as the file menu does, until every one of them arrives
+  std::set<std::string> names{"old.mp3"};
+
+  for (int i = 0; i < 500 && names != expected; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    util::Files added;
+    std::vector<util::File> removed;
+    EXPECT_FALSE(watcher->Consume(added, removed));
+
+    for (const auto& path : removed) names.erase(path.filename().string());
+    for (const auto& entry : added) names.insert(entry.path.filename().string());
+  }
+
+  EXPECT_EQ(names, expected);
+  EXPECT_LT(notifications, 50);
+
+  watcher.reset();
+  std::filesystem::remove_all(dir_path);
+}
+
+}  // namespace
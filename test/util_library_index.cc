@@ -0,0 +1,233 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "util/library_index.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+TEST(LibraryIndexTest, SearchFilesUnderRootAndReuseSavedIndex) {
+  const std::filesystem::path root{LISTDIR_PATH};
+  const auto cache_path = std::filesystem::temp_directory_path() / "spectrum_test_library.idx";
+  std::filesystem::remove(cache_path);
+
+  auto wait_for_update = [](const util::LibraryIndex& index) {
+    for (int i = 0; i < 500 && index.IsUpdating(); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return !index.IsUpdating();
+  };
+
+  {
+    util::LibraryIndex index(root, cache_path, nullptr);
+    ASSERT_TRUE(wait_for_update(index));
+
+    EXPECT_THAT(index.Search("BLOCK_S"), ElementsAre(root / "block_sidebar.cc"));
+    EXPECT_THAT(index.Search("mock/file_h"), ElementsAre(root / "mock" / "file_handler_mock.h"));
+    EXPECT_THAT(index.Search("_mock.h", 2), SizeIs(2));
+    EXPECT_THAT(index.Search("inexistent"), IsEmpty());
+
+    EXPECT_TRUE(std::filesystem::exists(cache_path));
+  }
+
+  // Nothing changed since last scan, so index loaded from disk is never replaced
+  util::LibraryIndex index(root, cache_path, nullptr);
+  ASSERT_TRUE(wait_for_update(index));
+
+  EXPECT_EQ(index.GetVersion(), 1);
+  EXPECT_THAT(index.Search("mock/file_h"), ElementsAre(root / "mock" / "file_handler_mock.h"));
+
+  std::filesystem::remove(cache_path);
+}
+
+/* ********************************************************************************************** */
+
+TEST(LibraryIndexTest, DiscardSavedIndexWithInvalidIdentifiers) {
+  const std::filesystem::path root{LISTDIR_PATH};
+  const auto cache_path = std::filesystem::temp_directory_path() / "spectrum_test_corrupted.idx";
+  std::filesystem::remove(cache_path);
+
+  auto wait_for_update = [](const util::LibraryIndex& index) {
+    for (int i = 0; i < 500 && index.IsUpdating(); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return !index.IsUpdating();
+  };
+
+  {
+    util::LibraryIndex index(root, cache_path, nullptr);
+    ASSERT_TRUE(wait_for_update(index));
+  }
+
+  // Index file ends with the last identifier from file postings
+  auto last_identifier = [&cache_path](std::optional<uint32_t> value = std::nullopt) {
+    std::fstream file(cache_path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(-static_cast<std::streamoff>(sizeof(uint32_t)), std::ios::end);
+
+    uint32_t id = 0;
+    if (value) {
+      id = *value;
+      file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    } else {
+      file.read(reinterpret_cast<char*>(&id), sizeof(id));
+    }
+
+    EXPECT_TRUE(file.good());
+    return id;
+  };
+
+  // Point it past every file
+  last_identifier(UINT32_MAX);
+
+  // Saved index must be discarded (instead of used for search), so it is replaced after a new scan
+  util::LibraryIndex index(root, cache_path, nullptr);
+  ASSERT_TRUE(wait_for_update(index));
+
+  EXPECT_NE(last_identifier(), UINT32_MAX);
+  EXPECT_THAT(index.Search("BLOCK_S"), ElementsAre(root / "block_sidebar.cc"));
+  EXPECT_THAT(index.Search("mock/file_h"), ElementsAre(root / "mock" / "file_handler_mock.h"));
+
+  std::filesystem::remove(cache_path);
+}
+
+/* ********************************************************************************************** */
+
+TEST(LibraryIndexTest, UpdateOnlyModifiedDirectories) {
+  const auto root = std::filesystem::temp_directory_path() / "spectrum_test_library";
+  const auto cache_path = std::filesystem::temp_directory_path() / "spectrum_test_update.idx";
+  std::filesystem::remove_all(root);
+  std::filesystem::remove(cache_path);
+
+  auto wait_for_update = [](const util::LibraryIndex& index) {
+    for (int i = 0; i < 500 && index.IsUpdating(); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return !index.IsUpdating();
+  };
+
+  auto create_file = [&root](const std::string& path) {
+    std::filesystem::create_directories((root / path).parent_path());
+    std::ofstream{root / path};
+  };
+
+  for (const auto& path : {"abba/gold.mp3", "beatles/help.mp3", "beatles/yesterday.mp3",
+                           "queen/jazz.mp3", "queen/innuendo.mp3"}) {
+    create_file(path);
+  }
+
+  util::LibraryIndex index(root, cache_path, nullptr);
+  ASSERT_TRUE(wait_for_update(index));
+
+  EXPECT_THAT(index.Search(".mp3"),
+              ElementsAre(root / "abba/gold.mp3", root / "beatles/help.mp3",
+                          root / "beatles/yesterday.mp3", root / "queen/innuendo.mp3",
+                          root / "queen/jazz.mp3"));
+
+  // Trigrams from directories listed before the modified one are reused, while all the others
+  // (and every file identifier from them) must be shifted to make room for the new file
+  create_file("beatles/abbey road.mp3");
+
+  index.Update();
+  ASSERT_TRUE(wait_for_update(index));
+
+  EXPECT_EQ(index.GetVersion(), 2);
+  EXPECT_THAT(index.Search("abb"),
+              ElementsAre(root / "abba/gold.mp3", root / "beatles/abbey road.mp3"));
+  EXPECT_THAT(index.Search("jazz"), ElementsAre(root / "queen/jazz.mp3"));
+  EXPECT_THAT(index.Search("yesterday"), ElementsAre(root / "beatles/yesterday.mp3"));
+  EXPECT_THAT(index.Search(".mp3"), SizeIs(6));
+
+  std::filesystem::remove_all(root);
+  std::filesystem::remove(cache_path);
+}
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(LibraryIndexTest, DISABLED_BenchmarkFiveHundredThousandPaths) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kArtists = 100, kAlbums = 10, kSongs = 500;
+
+  const auto root = std::filesystem::temp_directory_path() / "spectrum_bench_library";
+  const auto cache_path = std::filesystem::temp_directory_path() / "spectrum_bench_library.idx";
+  std::filesystem::remove_all(root);
+  std::filesystem::remove(cache_path);
+
+  for (int artist = 0; artist < kArtists; artist++) {
+    for (int album = 0; album < kAlbums; album++) {
+      auto dir = root / ("artist " + std::to_string(artist)) / ("album " + std::to_string(album));
+      std::filesystem::create_directories(dir);
+
+      for (int song = 0; song < kSongs; song++) {
+        std::ofstream{dir / ("track " + std::to_string(song) + " live remix.mp3")};
+      }
+    }
+  }
+
+  auto elapsed_since = [](Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+  };
+
+  auto wait_for_update = [](const util::LibraryIndex& index) {
+    while (index.IsUpdating()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+
+  auto start = Clock::now();
+  auto index = std::make_unique<util::LibraryIndex>(root, cache_path, nullptr);
+  wait_for_update(*index);
+  std::cout << "first scan=" << elapsed_since(start) << "ms\n";
+
+  // Rescan with nothing changed
+  start = Clock::now();
+  index->Update();
+  wait_for_update(*index);
+  std::cout << "unchanged rescan=" << elapsed_since(start) << "ms\n";
+
+  // Rescan after a single directory changed (in the middle of the library)
+  std::ofstream{root / "artist 50" / "album 5" / "new song.mp3"};
+
+  start = Clock::now();
+  index->Update();
+  wait_for_update(*index);
+  std::cout << "rescan after change=" << elapsed_since(start) << "ms\n";
+
+  for (const std::string query : {"l", "zz", "new song", "artist 99/album 9/track 499"}) {
+    start = Clock::now();
+    auto results = index->Search(query);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+    std::cout << "query=" << std::quoted(query) << " results=" << results.size()
+              << " elapsed=" << elapsed.count() << "us\n";
+  }
+
+  // Load saved index on a new execution
+  index.reset();
+
+  start = Clock::now();
+  index = std::make_unique<util::LibraryIndex>(root, cache_path, nullptr);
+  wait_for_update(*index);
+  std::cout << "load and rescan=" << elapsed_since(start) << "ms\n";
+
+  index.reset();
+  std::filesystem::remove_all(root);
+  std::filesystem::remove(cache_path);
+}
+
+}  // namespace
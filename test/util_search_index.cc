@@ -0,0 +1,81 @@
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "util/search_index.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(SearchIndexTest, NarrowWidenAndRankQuery) {
+  util::SearchIndex index;
+  for (const auto& name : {"Block_Sidebar.cc", "block_file_info.cc", "dialog_playlist.cc", ""}) {
+    index.Add(name);
+  }
+
+  EXPECT_THAT(index.Filter(""), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(index.Filter("B"), ElementsAre(0, 1));
+  EXPECT_THAT(index.Filter("bLoCk_s"), ElementsAre(0));
+  EXPECT_THAT(index.Filter("block"), ElementsAre(0, 1));
+  EXPECT_THAT(index.Filter(".cc"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(index.Filter("dpl"), ElementsAre(2));
+  EXPECT_THAT(index.Filter("mp3"), IsEmpty());
+
+  // Entries changed, so it must search through all of them again
+  index.Add("block_main_content.cc");
+  EXPECT_THAT(index.Filter("mp3"), IsEmpty());
+  EXPECT_THAT(index.Filter("block"), ElementsAre(0, 1, 4));
+
+  // Consecutive characters at the start of a word are the best match
+  EXPECT_THAT(index.Filter("co"), ElementsAre(4, 1));
+  EXPECT_THAT(index.Filter("co", 1), ElementsAre(4));
+}
+
+/* ********************************************************************************************** */
+
+// Benchmark is disabled by default, run it with --gtest_also_run_disabled_tests
+TEST(SearchIndexTest, DISABLED_BenchmarkTypingOnHundredThousandEntries) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int kEntries = 100000;
+
+  const std::vector<std::string> words{"track", "live", "remix", "the",      "best",
+                                       "of",    "song", "demo",  "acoustic", "version"};
+
+  util::SearchIndex index;
+  std::mt19937 generator(42);
+
+  for (int i = 0; i < kEntries; i++) {
+    std::string name;
+    for (int j = 0; j < 4; j++) name += words[generator() % words.size()] + " ";
+    index.Add(name + std::to_string(generator() % 1000) + ".mp3");
+  }
+
+  // Simulate user typing one character at a time
+  const std::string typed{"live remix 42"};
+  Clock::duration slowest{};
+
+  for (size_t size = 1; size <= typed.size(); size++) {
+    auto start = Clock::now();
+    const auto& results = index.Filter(typed.substr(0, size));
+    auto elapsed = Clock::now() - start;
+
+    std::cout << "query=" << std::quoted(typed.substr(0, size)) << " results=" << results.size()
+              << " elapsed="
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << "us\n";
+
+    slowest = std::max(slowest, elapsed);
+  }
+
+  EXPECT_LT(slowest, std::chrono::milliseconds(5));
+}
+
+}  // namespace